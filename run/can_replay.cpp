@@ -0,0 +1,141 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Replays a CAN recording made with --can_record onto a (virtual) CAN interface,
+ *              or exports it to candump log format.
+ *
+ *    make MAIN=run/can_replay.cpp TARGET=can_replay
+ *    ./can_replay <recording> [--interface=vcan0] [--speed=1] [--include_tx]
+ *    ./can_replay <recording> --export=<file.log> [--interface=can0]
+ *
+ *    --speed=0 replays as fast as the interface accepts frames.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <net/if.h>
+
+#if LINUX
+#include <linux/can.h>
+#endif
+
+#include <vector>
+
+#include "utils/io/can_recorder.hpp"
+#include "utils/logger.hpp"
+#include "utils/timer.hpp"
+
+using hyped::utils::Logger;
+using hyped::utils::Timer;
+using hyped::utils::io::CanRecorder;
+using hyped::utils::io::CanReplayer;
+using hyped::utils::io::can::Frame;
+using hyped::utils::io::can::Record;
+
+#if LINUX
+int openSocket(const char* interface, Logger& log)
+{
+  int fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  if (fd < 0) {
+    log.ERR("REPLAY", "could not open can socket");
+    return -1;
+  }
+  sockaddr_can addr = {};
+  addr.can_family   = AF_CAN;
+  addr.can_ifindex  = if_nametoindex(interface);
+  if (addr.can_ifindex == 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    log.ERR("REPLAY", "could not bind to %s", interface);
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int writeFrame(int fd, const Frame& frame)
+{
+  can_frame raw = {};
+  raw.can_id  = frame.id | (frame.extended ? Frame::kExtendedMask : 0);
+  raw.can_dlc = frame.len;
+  memcpy(raw.data, frame.data, frame.len);
+  if (write(fd, &raw, CAN_MTU) != CAN_MTU) return errno;
+  return 0;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+  Logger log(true, 0);
+  if (argc < 2) {
+    log.ERR("REPLAY", "usage: %s <recording> [--interface=vcan0] [--speed=1] [--include_tx] "
+            "[--export=<file.log>]", argv[0]);
+    return 1;
+  }
+
+  const char* recording   = argv[1];
+  const char* interface   = "vcan0";
+  const char* export_file = nullptr;
+  double      speed       = 1.0;
+  bool        include_tx  = false;
+  for (int i = 2; i < argc; i++) {
+    if (strncmp(argv[i], "--interface=", 12) == 0) {
+      interface = argv[i] + 12;
+    } else if (strncmp(argv[i], "--speed=", 8) == 0) {
+      speed = atof(argv[i] + 8);
+    } else if (strcmp(argv[i], "--include_tx") == 0) {
+      include_tx = true;
+    } else if (strncmp(argv[i], "--export=", 9) == 0) {
+      export_file = argv[i] + 9;
+    } else {
+      log.ERR("REPLAY", "unknown argument %s", argv[i]);
+      return 1;
+    }
+  }
+
+  if (export_file) {
+    if (!CanRecorder::exportCandump(recording, export_file, interface)) {
+      log.ERR("REPLAY", "could not export %s to %s", recording, export_file);
+      return 1;
+    }
+    log.INFO("REPLAY", "exported %s to %s", recording, export_file);
+    return 0;
+  }
+
+  std::vector<Record> records;
+  if (!CanRecorder::read(recording, &records)) {
+    log.ERR("REPLAY", "could not read recording %s", recording);
+    return 1;
+  }
+
+#if LINUX
+  int fd = openSocket(interface, log);
+  if (fd < 0) return 1;
+
+  CanReplayer replayer([fd](const Frame& frame) { return writeFrame(fd, frame); }, log);
+  uint64_t start   = Timer::getTimeMicros();
+  uint64_t written = replayer.replay(records, speed, include_tx);
+  uint64_t elapsed = Timer::getTimeMicros() - start;
+  log.INFO("REPLAY", "wrote %u of %u frames to %s in %.3f s, max lag %u us",
+           static_cast<uint32_t>(written), static_cast<uint32_t>(records.size()), interface,
+           elapsed * 1e-6, static_cast<uint32_t>(replayer.getMaxLag()));
+  close(fd);
+  return 0;
+#else
+  log.ERR("REPLAY", "replaying needs SocketCAN, only --export is available on this platform");
+  return 1;
+#endif
+}
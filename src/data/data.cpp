@@ -17,6 +17,10 @@
 
 #include "data/data.hpp"
 
+#include <algorithm>
+
+#include "utils/timer.hpp"
+
 namespace hyped {
 
 // imports
@@ -53,6 +57,90 @@ void Data::setStateMachineData(const StateMachine& sm_data)
 {
   ScopedLock L(&lock_state_machine_);
   state_machine_ = sm_data;
+  notifyUpdate(kChannelStateMachine);
+}
+
+uint32_t Data::waitForStateMachineData(uint32_t last, uint64_t timeout_micros)
+{
+  return waitForUpdates(kChannelStateMachine, last, timeout_micros);
+}
+
+uint32_t Data::getUpdates(uint32_t channels)
+{
+  ScopedLock L(&lock_updates_);
+  return sumUpdates(channels);
+}
+
+uint32_t Data::sumUpdates(uint32_t channels)
+{
+  // the counters only grow, so their sum changes with any of them
+  uint32_t updates = 0;
+  for (int i = 0; i < kNumChannels; i++) {
+    if (channels & (1u << i)) updates += updates_[i];
+  }
+  return updates;
+}
+
+uint32_t Data::waitForUpdates(uint32_t channels, uint32_t last, uint64_t timeout_micros)
+{
+  uint64_t deadline = utils::Timer::getTimeMicros() + timeout_micros;
+  ScopedLock L(&lock_updates_);
+  uint32_t updates = sumUpdates(channels);
+  if (updates != last) return updates;
+
+  Waiter waiter;
+  waiter.channels = channels;
+  waiters_.push_back(&waiter);
+  while (updates == last) {
+    uint64_t now = utils::Timer::getTimeMicros();
+    if (now >= deadline) break;
+    waiter.cv.waitFor(&lock_updates_, deadline - now);
+    updates = sumUpdates(channels);
+  }
+  for (auto it = waiters_.begin(); it != waiters_.end(); ++it) {
+    if (*it != &waiter) continue;
+    waiters_.erase(it);
+    break;
+  }
+  return updates;
+}
+
+uint64_t Data::getUpdateTime(uint32_t channels)
+{
+  ScopedLock L(&lock_updates_);
+  uint64_t time = 0;
+  for (int i = 0; i < kNumChannels; i++) {
+    if (channels & (1u << i)) time = std::max(time, update_times_[i]);
+  }
+  return time;
+}
+
+void Data::notifyUpdate(Channel channel)
+{
+  // the setters call this holding their own lock, the waiters only ever hold lock_updates_
+  uint64_t time = utils::Timer::getTimeMicros();
+  ScopedLock L(&lock_updates_);
+  for (int i = 0; i < kNumChannels; i++) {
+    if (channel != (1u << i)) continue;
+    updates_[i]++;
+    update_times_[i] = time;
+  }
+  for (Waiter* waiter : waiters_) {
+    if (waiter->channels & channel) waiter->cv.notify();
+  }
+}
+
+StateMachineStats Data::getStateMachineStats()
+{
+  ScopedLock L(&lock_state_machine_stats_);
+  return state_machine_stats_;
+}
+
+void Data::setStateMachineStats(const StateMachineStats& stats)
+{
+  ScopedLock L(&lock_state_machine_stats_);
+  state_machine_stats_ = stats;
+  notifyUpdate(kChannelStateMachineStats);
 }
 
 Navigation Data::getNavigationData()
@@ -65,6 +153,7 @@ void Data::setNavigationData(const Navigation& nav_data)
 {
   ScopedLock L(&lock_navigation_);
   navigation_ = nav_data;
+  notifyUpdate(kChannelNavigation);
 }
 
 Sensors Data::getSensorsData()
@@ -101,30 +190,35 @@ void Data::setTemperature(const int& temp)
 {
   ScopedLock L(&lock_temp_);
   temperature_ = temp;
+  notifyUpdate(kChannelTemperature);
 }
 
 void Data::setSensorsData(const Sensors& sensors_data)
 {
   ScopedLock L(&lock_sensors_);
   sensors_ = sensors_data;
+  notifyUpdate(kChannelSensors);
 }
 
 void Data::setSensorsImuData(const DataPoint<array<ImuData, Sensors::kNumImus>>& imu)
 {
   ScopedLock L(&lock_sensors_);
   sensors_.imu = imu;
+  notifyUpdate(kChannelSensors);
 }
 
 void Data::setSensorsEncoderData(const DataPoint<array<EncoderData, Sensors::kNumEncoders>>& encoder) //NOLINT
 {
   ScopedLock L(&lock_sensors_);
   sensors_.encoder = encoder;
+  notifyUpdate(kChannelSensors);
 }
 
 void Data::setSensorsKeyenceData(const array<StripeCounter, Sensors::kNumKeyence>& keyence_stripe_counter) //NOLINT
 {
   ScopedLock L(&lock_sensors_);
   sensors_.keyence_stripe_counter = keyence_stripe_counter;
+  notifyUpdate(kChannelSensors);
 }
 
 Batteries Data::getBatteriesData()
@@ -137,6 +231,7 @@ void Data::setBatteriesData(const Batteries& batteries_data)
 {
   ScopedLock L(&lock_batteries_);
   batteries_ = batteries_data;
+  notifyUpdate(kChannelBatteries);
 }
 
 EmergencyBrakes Data::getEmergencyBrakesData()
@@ -149,6 +244,16 @@ void Data::setEmergencyBrakesData(const EmergencyBrakes& emergency_brakes_data)
 {
   ScopedLock L(&lock_emergency_brakes_);
   emergency_brakes_ = emergency_brakes_data;
+  notifyUpdate(kChannelEmergencyBrakes);
+}
+
+void Data::setEmergencyBrakesButton(int brake, bool retracted, uint64_t time, bool failed)
+{
+  ScopedLock L(&lock_emergency_brakes_);
+  emergency_brakes_.brakes_retracted[brake] = retracted;
+  emergency_brakes_.button_time[brake]      = time;
+  if (failed) emergency_brakes_.module_status = ModuleStatus::kCriticalFailure;
+  notifyUpdate(kChannelEmergencyBrakes);
 }
 
 Motors Data::getMotorData()
@@ -161,6 +266,7 @@ void Data::setMotorData(const Motors& motor_data)
 {
   ScopedLock L(&lock_motors_);
   motors_ = motor_data;
+  notifyUpdate(kChannelMotors);
 }
 
 Telemetry Data::getTelemetryData()
@@ -173,6 +279,7 @@ void Data::setTelemetryData(const Telemetry& telemetry_data)
 {
   ScopedLock L(&lock_telemetry_);
   telemetry_ = telemetry_data;
+  notifyUpdate(kChannelTelemetry);
 }
 
 }}  // namespace data::hyped
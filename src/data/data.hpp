@@ -23,8 +23,10 @@
 #include <cstdint>
 #include <array>
 #include <vector>
+#include "utils/math/histogram.hpp"
 #include "utils/math/vector.hpp"
 #include "data/data_point.hpp"
+#include "utils/concurrent/condition_variable.hpp"
 #include "utils/concurrent/lock.hpp"
 
 using std::array;
@@ -66,6 +68,7 @@ struct Navigation : public Module {
   nav_t  acceleration;                             // m/s^2
   nav_t  emergency_braking_distance;               // m
   nav_t  braking_distance = 750;                   // m
+  uint32_t timestamp = 0;                          // us of the sensor data it was computed from
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -123,6 +126,13 @@ struct Batteries : public Module {
   static constexpr int kNumLPBatteries = 3;
   static constexpr int kNumHPBatteries = 2;
 
+  // range BmsManager::batteriesInRange accepts from a high power pack
+  static constexpr int kMinHPVoltage      = 1000;   // dV
+  static constexpr int kMaxHPVoltage      = 1296;   // dV
+  static constexpr int kMaxHPCurrent      = 3500;   // dA
+  static constexpr int kMinHPTemperature  = 10;     // C
+  static constexpr int kMaxHPTemperature  = 65;     // C
+
   array<BatteryData, kNumLPBatteries> low_power_batteries;
   array<BatteryData, kNumHPBatteries> high_power_batteries;
 };
@@ -131,6 +141,8 @@ struct EmergencyBrakes : public Module {
   static constexpr int kBrakeCommandWaitTime   = 1000;    // milliseconds
   static constexpr int kNumEmbrakes            = 2;
   bool brakes_retracted[kNumEmbrakes]          = {false};  // true if brakes retract
+  uint32_t command_latency[kNumEmbrakes]       = {0};      // us from last command to confirmation
+  uint64_t button_time[kNumEmbrakes]           = {0};      // us of the last change of a button
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -179,9 +191,30 @@ struct StateMachine {
   State current_state;
 };
 
+struct StateMachineStats {
+  utils::math::Histogram tick_time;             // us to check for a transition
+  utils::math::Histogram transition_latency;    // us from the data triggering it to the new state
+};
+
 // -------------------------------------------------------------------------------------------------
 // Common Data structure/class
 // -------------------------------------------------------------------------------------------------
+/**
+ * @brief      One bit per data structure, a set of them is what a module waits for updates of
+ */
+enum Channel : uint32_t {
+  kChannelStateMachine      = 1 << 0,
+  kChannelNavigation        = 1 << 1,
+  kChannelSensors           = 1 << 2,
+  kChannelTemperature       = 1 << 3,
+  kChannelBatteries         = 1 << 4,
+  kChannelEmergencyBrakes   = 1 << 5,
+  kChannelMotors            = 1 << 6,
+  kChannelTelemetry         = 1 << 7,
+  kChannelStateMachineStats = 1 << 8,
+};
+constexpr int kNumChannels = 9;
+
 /**
  * @brief      A singleton class managing the data exchange between sub-team
  * threads.
@@ -203,6 +236,44 @@ class Data {
    */
   void setStateMachineData(const StateMachine& sm_data);
 
+  /**
+   * @brief      Blocks until the state machine data is set after the update numbered last,
+   *             or at most for timeout_micros. Lets modules sleep until the state changes
+   *             instead of polling it.
+   *
+   * @return     number of the latest update, last if there was none before the timeout
+   */
+  uint32_t waitForStateMachineData(uint32_t last, uint64_t timeout_micros);
+
+  /**
+   * @brief      Number of times the structures of channels were set, a bitwise or of Channel
+   */
+  uint32_t getUpdates(uint32_t channels);
+
+  /**
+   * @brief      Blocks until any structure of channels is set after getUpdates returned last,
+   *             or at most for timeout_micros.
+   *
+   * @return     getUpdates(channels) on return, last if there was no update before the timeout
+   */
+  uint32_t waitForUpdates(uint32_t channels, uint32_t last, uint64_t timeout_micros);
+
+  /**
+   * @brief      Microseconds of utils::Timer when any structure of channels was last set, 0 if
+   *             none of them was yet
+   */
+  uint64_t getUpdateTime(uint32_t channels);
+
+  /**
+   * @brief      Retrieves the timing histograms of the state machine.
+   */
+  StateMachineStats getStateMachineStats();
+
+  /**
+   * @brief      Should be called by the state machine to publish its timing histograms.
+   */
+  void setStateMachineStats(const StateMachineStats& stats);
+
   /**
    * @brief      Retrieves data produced by navigation sub-team.
    */
@@ -285,6 +356,13 @@ class Data {
    */
   void setEmergencyBrakesData(const EmergencyBrakes& emergency_brakes_data);
 
+  /**
+   * @brief      Records a change of the button of one brake at time, and a critical failure if
+   *             failed. Only those fields are written, so a button watched from another thread
+   *             does not overwrite what the embrakes thread set in the meantime.
+   */
+  void setEmergencyBrakesButton(int brake, bool retracted, uint64_t time, bool failed);
+
   /**
    * @brief      Retrieves data produced by each of the four motors.
    */
@@ -307,6 +385,7 @@ class Data {
 
  private:
   StateMachine state_machine_;
+  StateMachineStats state_machine_stats_;
   Navigation navigation_;
   Sensors sensors_;
   Motors motors_;
@@ -314,10 +393,30 @@ class Data {
   Telemetry telemetry_;
   EmergencyBrakes emergency_brakes_;
   int temperature_;  // In degrees C
+  uint32_t updates_[kNumChannels] = {0};
+  uint64_t update_times_[kNumChannels] = {0};
+
+  // a thread in waitForUpdates, only woken by updates of its channels
+  struct Waiter {
+    uint32_t channels;
+    utils::concurrent::ConditionVariable cv;
+  };
+  vector<Waiter*> waiters_;
+
+  /**
+   * @brief      Counts an update of channel and wakes the modules waiting for it
+   */
+  void notifyUpdate(Channel channel);
+
+  /**
+   * @brief      Sum of the counters of channels, lock_updates_ must be held
+   */
+  uint32_t sumUpdates(uint32_t channels);
 
 
   // locks for data substructures
   Lock lock_state_machine_;
+  Lock lock_state_machine_stats_;
   Lock lock_navigation_;
   Lock lock_sensors_;
   Lock lock_motors_;
@@ -326,6 +425,7 @@ class Data {
   Lock lock_telemetry_;
   Lock lock_batteries_;
   Lock lock_emergency_brakes_;
+  Lock lock_updates_;
 
   Data() {}
 
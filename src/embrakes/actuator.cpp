@@ -0,0 +1,108 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Drives one brake without blocking
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "embrakes/actuator.hpp"
+
+namespace hyped {
+namespace embrakes {
+
+constexpr uint64_t Actuator::kDeadline;
+constexpr uint64_t Actuator::kMonitorPeriod;
+
+Actuator::Actuator(Logger& log, StepperInterface* stepper, uint8_t id)
+    : log_(log),
+      stepper_(stepper),
+      id_(id),
+      target_(stepper->checkClamped() ? Command::kClamp : Command::kRetract),
+      pending_(false),
+      confirmed_(false),
+      sent_(0),
+      deadline_(UINT64_MAX),      // nothing to check before the first command
+      latency_(0)
+{}
+
+void Actuator::command(Command command, uint64_t now)
+{
+  if (command == Command::kNone || command == target_) return;
+
+  if (command == Command::kClamp) {
+    stepper_->sendClamp();
+  } else {
+    stepper_->sendRetract();
+  }
+  target_    = command;
+  pending_   = true;
+  confirmed_ = false;
+  sent_      = now;
+  deadline_  = now + kDeadline;
+}
+
+void Actuator::update(uint64_t now)
+{
+  stepper_->checkHome();
+  bool retracted = stepper_->checkRetracted();
+  bool done      = (target_ == Command::kRetract) == retracted;
+
+  if (pending_) {
+    if (done) {
+      pending_   = false;
+      confirmed_ = true;
+      latency_   = now - sent_;
+      deadline_  = now + kMonitorPeriod;
+      log_.DBG1("Brakes", "Brake %d confirmed after %lu us", id_,
+                static_cast<unsigned long>(latency_));    // NOLINT [runtime/int]
+    } else if (now >= deadline_) {
+      // the same check that used to run after sleeping for the wait time
+      pending_  = false;
+      deadline_ = now + kMonitorPeriod;
+      checkFailure();
+    }
+    return;
+  }
+
+  confirmed_ = done;
+  if (now >= deadline_) {
+    deadline_ = now + kMonitorPeriod;
+    checkFailure();
+  }
+}
+
+void Actuator::checkFailure()
+{
+  if (target_ == Command::kClamp) {
+    stepper_->checkBrakingFailure();
+  } else {
+    stepper_->checkAccFailure();
+  }
+}
+
+bool Actuator::isConfirmed() const
+{
+  return confirmed_;
+}
+
+Actuator::Command Actuator::getTarget() const
+{
+  return target_;
+}
+
+uint64_t Actuator::getLatency() const
+{
+  return latency_;
+}
+
+}}  // namespace hyped::embrakes
@@ -0,0 +1,96 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Drives one brake without blocking. A command is sent to the stepper at once and the brake is
+ * then checked on every update until its button confirms the command or the deadline of
+ * kBrakeCommandWaitTime passes, in which case the failure check of the stepper runs. A new
+ * command replaces a pending one straight away, so a brake that is still retracting clamps as
+ * soon as it is told to.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef EMBRAKES_ACTUATOR_HPP_
+#define EMBRAKES_ACTUATOR_HPP_
+
+#include <cstdint>
+
+#include "data/data.hpp"
+#include "embrakes/interface.hpp"
+#include "utils/logger.hpp"
+
+namespace hyped {
+
+using utils::Logger;
+
+namespace embrakes {
+
+class Actuator {
+ public:
+  enum class Command {
+    kNone,              // keep the last command
+    kClamp,
+    kRetract,
+  };
+
+  // microseconds a brake has to confirm a command
+  static constexpr uint64_t kDeadline =
+      data::EmergencyBrakes::kBrakeCommandWaitTime * static_cast<uint64_t>(1000);
+  // microseconds between failure checks once a command is done with
+  static constexpr uint64_t kMonitorPeriod = 100000;
+
+  /**
+   * @param stepper - the brake, the clamp state it reports is taken as the last command
+   */
+  Actuator(Logger& log, StepperInterface* stepper, uint8_t id);
+
+  /**
+   * @brief Send command to the brake unless it is the last one sent, returns at once
+   * @param now - microseconds, the clock update() gets
+   */
+  void command(Command command, uint64_t now);
+
+  /**
+   * @brief Check on the brake, call at least once per scheduler tick
+   */
+  void update(uint64_t now);
+
+  /**
+   * @return true iff the button confirmed the last command
+   */
+  bool isConfirmed() const;
+
+  Command getTarget() const;
+
+  /**
+   * @return microseconds from the last confirmed command to its confirmation, 0 if none yet
+   */
+  uint64_t getLatency() const;
+
+ private:
+  void checkFailure();
+
+  Logger&           log_;
+  StepperInterface* stepper_;
+  uint8_t           id_;
+  Command           target_;
+  bool              pending_;       // sent, neither confirmed nor past its deadline
+  bool              confirmed_;
+  uint64_t          sent_;          // when the last command was sent
+  uint64_t          deadline_;      // of the pending command, or of the next failure check
+  uint64_t          latency_;
+};
+
+}}  // namespace hyped::embrakes
+
+#endif  // EMBRAKES_ACTUATOR_HPP_
@@ -34,9 +34,11 @@ FakeStepper::FakeStepper(Logger& log, uint8_t id)
 void FakeStepper::checkHome()
 {
   if (fake_button_ && !em_brakes_data_.brakes_retracted[brake_id_-1]) {
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.brakes_retracted[brake_id_-1] = true;
     data_.setEmergencyBrakesData(em_brakes_data_);
   } else if (!fake_button_ && em_brakes_data_.brakes_retracted[brake_id_-1]) {
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.brakes_retracted[brake_id_-1] = false;
     data_.setEmergencyBrakesData(em_brakes_data_);
   }
@@ -60,6 +62,7 @@ void FakeStepper::checkAccFailure()
 {
   if (!fake_button_) {  // false = brakes are clamped
     log_.ERR("Brakes", "Brake %b failure", brake_id_);
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.module_status = ModuleStatus::kCriticalFailure;
     data_.setEmergencyBrakesData(em_brakes_data_);
   }
@@ -70,6 +73,7 @@ void FakeStepper::checkBrakingFailure()
 {
   if (fake_button_) {  // true = brakes are retracted
     log_.ERR("Brakes", "Brake %b failure", brake_id_);
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.module_status = ModuleStatus::kCriticalFailure;
     data_.setEmergencyBrakesData(em_brakes_data_);
   }
@@ -77,5 +81,7 @@ void FakeStepper::checkBrakingFailure()
 }
 
 bool FakeStepper::checkClamped() { return is_clamped_; }
+
+bool FakeStepper::checkRetracted() { return fake_button_; }
 }  // namespace embrakes
 }  // namespace hyped
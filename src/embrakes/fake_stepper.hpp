@@ -74,6 +74,11 @@ class FakeStepper : public StepperInterface {
 
   bool checkClamped() override;
 
+  /**
+   * @brief reads the button, true iff the brake is retracted
+   */
+  bool checkRetracted() override;
+
  private:
   utils::Logger& log_;
   data::Data& data_;
@@ -33,6 +33,8 @@ class StepperInterface {
   virtual void checkAccFailure() = 0;
   virtual void checkBrakingFailure() = 0;
   virtual bool checkClamped() = 0;
+  // true iff the button reports the brake retracted, whatever was commanded
+  virtual bool checkRetracted() = 0;
 
   // Explicit virtual deconstructor needs to be declared *and* defined
   virtual ~StepperInterface() {}
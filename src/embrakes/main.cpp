@@ -18,6 +18,7 @@
 
 #include "main.hpp"
 #include "utils/config.hpp"
+#include "utils/timer.hpp"
 
 namespace hyped {
 namespace embrakes {
@@ -26,7 +27,8 @@ Main::Main(uint8_t id, Logger &log)
   : Thread(id, log),
     log_(log),
     data_(data::Data::getInstance()),
-    sys_(utils::System::getSystem())
+    sys_(utils::System::getSystem()),
+    monitor_(nullptr)
 {
   // parse GPIO pins from config.txt file
   for (int i = 0; i < 2; i++) {
@@ -37,9 +39,13 @@ Main::Main(uint8_t id, Logger &log)
     m_brake_ = new FakeStepper(log_, 1);
     f_brake_ = new FakeStepper(log_, 2);
   } else {
-    m_brake_ = new Stepper(command_pins_[0], button_pins_[0], log_, 1);
-    f_brake_ = new Stepper(command_pins_[1], button_pins_[1], log_, 2);
+    // one thread waits on both buttons, a brake that moves is in data within microseconds
+    monitor_ = new utils::io::GpioMonitor(log_);
+    m_brake_ = new Stepper(command_pins_[0], button_pins_[0], log_, 1, monitor_);
+    f_brake_ = new Stepper(command_pins_[1], button_pins_[1], log_, 2, monitor_);
   }
+  actuators_[0] = new Actuator(log_, m_brake_, 1);
+  actuators_[1] = new Actuator(log_, f_brake_, 2);
 }
 
 void Main::run()
@@ -50,123 +56,88 @@ void Main::run()
   data_.setEmergencyBrakesData(em_brakes_);
 
   log_.INFO("Brakes", "Thread started");
+  if (monitor_) monitor_->start();
 
   System &sys = System::getSystem();
 
+  uint32_t update = 0;
   while (sys.running_) {
     // Get the current state of embrakes, state machine and telemetry modules from data
     em_brakes_ = data_.getEmergencyBrakesData();
     sm_data_ = data_.getStateMachineData();
     tlm_data_ = data_.getTelemetryData();
 
+    Actuator::Command command = Actuator::Command::kNone;
     switch (sm_data_.current_state) {
       case data::State::kIdle:
-        if (tlm_data_.nominal_braking_command) {
-          if (!m_brake_->checkClamped()) {
-            m_brake_->sendClamp();
-          }
-          if (!f_brake_->checkClamped()) {
-            f_brake_->sendClamp();
-          }
-          Thread::sleep(data::EmergencyBrakes::kBrakeCommandWaitTime);
-          m_brake_->checkHome();
-          f_brake_->checkHome();
-
-          m_brake_->checkBrakingFailure();
-          f_brake_->checkBrakingFailure();
-        } else {
-           if (m_brake_->checkClamped()) {
-            m_brake_->sendRetract();
-          }
-          if (f_brake_->checkClamped()) {
-            f_brake_->sendRetract();
-          }
-
-          Thread::sleep(data::EmergencyBrakes::kBrakeCommandWaitTime);
-          m_brake_->checkHome();
-          f_brake_->checkHome();
-
-          m_brake_->checkAccFailure();
-          f_brake_->checkAccFailure();
-        }
+      case data::State::kFinished:
+        command = tlm_data_.nominal_braking_command ? Actuator::Command::kClamp
+                                                    : Actuator::Command::kRetract;
         break;
       case data::State::kCalibrating:
-        if (m_brake_->checkClamped()) {
-          m_brake_->sendRetract();
-        }
-        if (f_brake_->checkClamped()) {
-          f_brake_->sendRetract();
-        }
-
-        if (!m_brake_->checkClamped() && !f_brake_->checkClamped()) {
-          em_brakes_.module_status = ModuleStatus::kReady;
-          data_.setEmergencyBrakesData(em_brakes_);
-        }
-
-        Thread::sleep(data::EmergencyBrakes::kBrakeCommandWaitTime);
-        m_brake_->checkHome();
-        f_brake_->checkHome();
-        m_brake_->checkAccFailure();
-        f_brake_->checkAccFailure();
-        break;
-      case data::State::kAccelerating:
-      case data::State::kCruising:
-        m_brake_->checkAccFailure();
-        f_brake_->checkAccFailure();
+        command = Actuator::Command::kRetract;
         break;
       case data::State::kNominalBraking:
       case data::State::kEmergencyBraking:
-        if (!m_brake_->checkClamped()) {
-          m_brake_->sendClamp();
-        }
-        if (!f_brake_->checkClamped()) {
-          f_brake_->sendClamp();
-        }
-        Thread::sleep(data::EmergencyBrakes::kBrakeCommandWaitTime);
-        m_brake_->checkHome();
-        f_brake_->checkHome();
-
-        m_brake_->checkBrakingFailure();
-        f_brake_->checkBrakingFailure();
-        break;
-      case data::State::kFinished:
-        if (tlm_data_.nominal_braking_command) {
-          if (!m_brake_->checkClamped()) {
-            m_brake_->sendClamp();
-          }
-          if (!f_brake_->checkClamped()) {
-            f_brake_->sendClamp();
-          }
-          Thread::sleep(data::EmergencyBrakes::kBrakeCommandWaitTime);
-          m_brake_->checkHome();
-          f_brake_->checkHome();
-          m_brake_->checkBrakingFailure();
-          f_brake_->checkBrakingFailure();
-        } else {
-          if (m_brake_->checkClamped()) {
-            m_brake_->sendRetract();
-          }
-          if (f_brake_->checkClamped()) {
-            f_brake_->sendRetract();
-          }
-          Thread::sleep(data::EmergencyBrakes::kBrakeCommandWaitTime);
-          m_brake_->checkHome();
-          f_brake_->checkHome();
-          m_brake_->checkAccFailure();
-          f_brake_->checkAccFailure();
-        }
+        command = Actuator::Command::kClamp;
         break;
       default:
+        // accelerating and cruising the brakes stay as they are and are checked for failure
         break;
     }
+
+    // both brakes get their command before either is checked, so they move at the same time
+    uint64_t now = utils::Timer::getTimeMicros();
+    for (Actuator* actuator : actuators_) actuator->command(command, now);
+    for (Actuator* actuator : actuators_) actuator->update(now);
+    publishLatencies();
+
+    if (sm_data_.current_state == data::State::kCalibrating && isRetracted()) {
+      em_brakes_ = data_.getEmergencyBrakesData();
+      if (em_brakes_.module_status == ModuleStatus::kInit) {
+        em_brakes_.module_status = ModuleStatus::kReady;
+        data_.setEmergencyBrakesData(em_brakes_);
+      }
+    }
+
+    // a new state wakes the loop at once, telemetry commands and the brakes within a tick
+    update = data_.waitForStateMachineData(update, kTickPeriod);
+  }
+  if (monitor_) {
+    monitor_->stop();
+    monitor_->join();
   }
   log_.INFO("Brakes", "Thread shutting down");
 }
 
+bool Main::isRetracted()
+{
+  for (Actuator* actuator : actuators_) {
+    if (actuator->getTarget() != Actuator::Command::kRetract) return false;
+    if (!actuator->isConfirmed()) return false;
+  }
+  return true;
+}
+
+void Main::publishLatencies()
+{
+  em_brakes_ = data_.getEmergencyBrakesData();
+  bool changed = false;
+  for (int i = 0; i < data::EmergencyBrakes::kNumEmbrakes; i++) {
+    uint32_t latency = actuators_[i]->getLatency();
+    if (em_brakes_.command_latency[i] == latency) continue;
+    em_brakes_.command_latency[i] = latency;
+    changed = true;
+  }
+  if (changed) data_.setEmergencyBrakesData(em_brakes_);
+}
+
 Main::~Main()
 {
+  for (Actuator* actuator : actuators_) delete actuator;
   delete f_brake_;
   delete m_brake_;
+  delete monitor_;
 }
 
 }  // namespace embrakes
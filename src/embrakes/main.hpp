@@ -22,8 +22,10 @@
 #include "utils/concurrent/thread.hpp"
 #include "utils/system.hpp"
 #include "utils/logger.hpp"
+#include "utils/io/gpio_monitor.hpp"
 #include "data/data.hpp"
 
+#include "embrakes/actuator.hpp"
 #include "embrakes/stepper.hpp"
 #include "embrakes/fake_stepper.hpp"
 
@@ -58,6 +60,19 @@ class Main : public Thread
 
 
   private:
+    // longest the loop sleeps, it wakes at once on a new state
+    static constexpr uint64_t kTickPeriod = 10000;    // microseconds
+
+    /**
+     * @brief True iff both brakes confirmed their retract command
+     */
+    bool isRetracted();
+
+    /**
+     * @brief Writes the command latencies of the brakes to data if they changed
+     */
+    void publishLatencies();
+
     Logger&                log_;
     data::Data&            data_;
     utils::System&         sys_;
@@ -68,6 +83,8 @@ class Main : public Thread
     uint8_t                button_pins_[2];   // GPIO pin numbers for retrieving brake status
     StepperInterface*      m_brake_;          // Stepper for electromagnetic brakes
     StepperInterface*      f_brake_;          // Stepper for friction brakes
+    Actuator*              actuators_[data::EmergencyBrakes::kNumEmbrakes];  // of m_, f_brake_
+    utils::io::GpioMonitor* monitor_;         // edges of the buttons, none for fake brakes
 };
 
 }}
@@ -21,25 +21,33 @@
 namespace hyped {
 namespace embrakes {
 
-Stepper::Stepper(uint8_t enable_pin, uint8_t button_pin, Logger& log, uint8_t id)
+constexpr uint64_t Stepper::kDebounceTime;
+
+Stepper::Stepper(uint8_t enable_pin, uint8_t button_pin, Logger& log, uint8_t id,
+                 utils::io::GpioMonitor* monitor)
     : log_(log),
       data_(data::Data::getInstance()),
       em_brakes_data_(data_.getEmergencyBrakesData()),
       command_pin_(enable_pin, utils::io::gpio::kOut, log_),
       button_(button_pin, utils::io::gpio::kIn, log_),
       brake_id_(id),
-      is_clamped_(true)
+      is_clamped_(true),
+      watched_(false),
+      settled_(false),
+      settled_time_(0)
 {
-  GPIO command_pin_(enable_pin, utils::io::gpio::kOut, log_);
-  GPIO button_(button_pin, utils::io::gpio::kIn, log_);
+  if (monitor) watched_ = monitor->watch(&button_, this);
 }
 
 void Stepper::checkHome()
 {
+  if (watched_) return;     // every edge is in data already
   if (button_.read() && !em_brakes_data_.brakes_retracted[brake_id_-1]) {
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.brakes_retracted[brake_id_-1] = true;
     data_.setEmergencyBrakesData(em_brakes_data_);
   } else if (!button_.read() && em_brakes_data_.brakes_retracted[brake_id_-1]) {
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.brakes_retracted[brake_id_-1] = false;
     data_.setEmergencyBrakesData(em_brakes_data_);
   }
@@ -48,21 +56,24 @@ void Stepper::checkHome()
 void Stepper::sendRetract()
 {
   log_.INFO("Brakes", "Sending a retract message to brake %i", brake_id_);
-  command_pin_.clear();
+  if (is_clamped_) settled_ = false;
   is_clamped_ = false;
+  command_pin_.clear();
 }
 
 void Stepper::sendClamp()
 {
   log_.INFO("Brakes", "Sending a engage message to brake %i", brake_id_);
-  command_pin_.set();
+  if (!is_clamped_) settled_ = false;
   is_clamped_ = true;
+  command_pin_.set();
 }
 
 void Stepper::checkAccFailure()
 {
   if (!button_.read()) {  // false = brakes are clamped
     log_.ERR("Brakes", "Brake %b failure", brake_id_);
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.module_status = ModuleStatus::kCriticalFailure;
     data_.setEmergencyBrakesData(em_brakes_data_);
   }
@@ -72,6 +83,7 @@ void Stepper::checkBrakingFailure()
 {
   if (button_.read()) {  // true = brakes are retracted
     log_.ERR("Brakes", "Brake %b failure", brake_id_);
+    em_brakes_data_ = data_.getEmergencyBrakesData();
     em_brakes_data_.module_status = ModuleStatus::kCriticalFailure;
     data_.setEmergencyBrakesData(em_brakes_data_);
   }
@@ -82,4 +94,24 @@ bool Stepper::checkClamped()
   return is_clamped_;
 }
 
+bool Stepper::checkRetracted()
+{
+  return button_.read();
+}
+
+void Stepper::onEdge(uint8_t value, uint64_t time)
+{
+  bool retracted = value;   // true = brakes are retracted
+  bool failed    = false;
+  if (retracted != is_clamped_) {
+    if (!settled_) settled_time_ = time;
+    settled_ = true;
+  } else if (settled_ && time - settled_time_ >= kDebounceTime) {
+    // a bounce as the brake arrives is left to the checks of the actuator
+    log_.ERR("Brakes", "Brake %d left its position on its own", brake_id_);
+    failed = true;
+  }
+  data_.setEmergencyBrakesButton(brake_id_-1, retracted, time, failed);
+}
+
 }}  // namespace hyped::embrakes
@@ -19,8 +19,11 @@
 #ifndef EMBRAKES_STEPPER_HPP_
 #define EMBRAKES_STEPPER_HPP_
 
+#include <atomic>
+
 #include "utils/logger.hpp"
 #include "utils/io/gpio.hpp"
+#include "utils/io/gpio_monitor.hpp"
 #include "utils/system.hpp"
 #include "utils/concurrent/thread.hpp"
 #include "data/data.hpp"
@@ -35,13 +38,19 @@ using data::ModuleStatus;
 
 namespace embrakes {
 
-class Stepper : public StepperInterface {
+class Stepper : public StepperInterface, public utils::io::GpioMonitor::Listener {
  public:
+  // microseconds a button has to stay where it was commanded before leaving counts as a failure
+  static constexpr uint64_t kDebounceTime = 5000;
+
   /**
    * @brief Construct a new Stepper object
    * @param log, node id
+   * @param monitor - pushes the edges of the button into data as they happen, without it the
+   *                  button is only read when checked
    */
-  Stepper(uint8_t enable_pin, uint8_t button_pin, Logger& log, uint8_t id);
+  Stepper(uint8_t enable_pin, uint8_t button_pin, Logger& log, uint8_t id,
+          utils::io::GpioMonitor* monitor = nullptr);
 
   /**
    * @brief Deconstruct a Stepper object even if behind `StepperInterface *`
@@ -72,6 +81,17 @@ class Stepper : public StepperInterface {
 
   bool checkClamped() override;
 
+  /**
+   * @brief reads the button, true iff the brake is retracted
+   */
+  bool checkRetracted() override;
+
+  /**
+   * @brief Records the new button state in data, a brake leaving the position it was commanded
+   * to and had reached is a failure at once
+   */
+  void onEdge(uint8_t value, uint64_t time) override;
+
  private:
   utils::Logger&        log_;
   data::Data&           data_;
@@ -79,7 +99,10 @@ class Stepper : public StepperInterface {
   GPIO                  command_pin_;
   GPIO                  button_;
   uint8_t               brake_id_;
-  uint8_t               is_clamped_;
+  std::atomic<bool>     is_clamped_;
+  bool                  watched_;         // the monitor keeps data up to date
+  std::atomic<bool>     settled_;         // button reached the last command
+  uint64_t              settled_time_;    // of the monitor, when it did
 };
 
 }}  // namespace hyped::embrakes
@@ -77,6 +77,8 @@ namespace navigation {
           navigation_complete = true;
           break;
       }
+      // polls as fast as it can, but lets a simulation move on
+      Thread::yield();
     }
   }
 }}  // namespace hyped::navigation
@@ -446,6 +446,7 @@ void Navigation::updateData()
   nav_data.acceleration               = getAcceleration();
   nav_data.emergency_braking_distance = getEmergencyBrakingDistance();
   nav_data.braking_distance           = 1.2 * getEmergencyBrakingDistance();
+  nav_data.timestamp                  = displacement_.timestamp;
 
   data_.setNavigationData(nav_data);
 
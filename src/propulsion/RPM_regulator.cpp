@@ -19,60 +19,99 @@
  *    limitations under the License.
  */
 
-#include <vector>
 #include "propulsion/RPM_regulator.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace hyped {
 
 namespace motor_control {
 
+constexpr uint64_t RPM_Regulator::kPeriod;
+constexpr double   RPM_Regulator::kProportional;
+constexpr double   RPM_Regulator::kIntegral;
+constexpr double   RPM_Regulator::kMaxRpmRate;
+constexpr double   RPM_Regulator::kMaxVelocity;
+constexpr double   RPM_Regulator::kTableStep;
+constexpr int32_t  RPM_Regulator::kMaxCurrent;
+constexpr double   RPM_Regulator::kCurrentBand;
+constexpr double   RPM_Regulator::kTempBand;
+
 RPM_Regulator::RPM_Regulator(Logger& log)
   : log_(log),
-    current_index(0),
+    reference_(0),
+    integral_(0),
+    current_limit_(kMaxCurrent),
     failure(false)
 {
+  int entries = std::lround(kMaxVelocity / kTableStep) + 1;
+  table_.reserve(entries);
+  for (int i = 0; i < entries; i++) {
+    table_.push_back(std::min<double>(calculateOptimalRPM(i * kTableStep), MAX_RPM));
+  }
+}
+
+void RPM_Regulator::reset(int32_t act_rpm)
+{
+  reference_ = act_rpm;
+  integral_  = 0;
+}
+
+void RPM_Regulator::setCurrentLimit(int32_t limit)
+{
+  current_limit_ = limit;
 }
 
-int32_t RPM_Regulator::calculateRPM(int32_t act_velocity, int32_t act_rpm,
+int32_t RPM_Regulator::calculateRPM(float act_velocity, int32_t act_rpm,
                                     int32_t act_current, int32_t act_temp)
 {
-  int32_t opt_rpm = calculateOptimalRPM(act_velocity);
-  if (act_temp <= MAX_TEMP) {
-    if (act_current < MAX_CURRENT &&
-        act_temp < MAX_TEMP &&
-        act_rpm < opt_rpm) {
-      return act_rpm + step(opt_rpm, true);
-    } else if (act_current > MAX_CURRENT ||
-              act_temp > MAX_TEMP ||
-              act_rpm > opt_rpm) {
-      int32_t target = act_rpm - step(opt_rpm, false);
-      if (target < 0) {
-        return 0;
-      } else {
-        return target;
-      }
-    } else {
-      return act_rpm;
-    }
+  constexpr double dt = kPeriod / 1e6;
+
+  // the reference approaches the optimal rpm at a bounded rate
+  double optimal  = getOptimalRPM(act_velocity);
+  double max_step = kMaxRpmRate * dt;
+  reference_ += std::max(-max_step, std::min(max_step, optimal - reference_));
+
+  double error  = reference_ - act_rpm;
+  double output = reference_ + kProportional * error + kIntegral * (integral_ + error * dt);
+
+  // near a limit the target may only rise slowly, beyond it the target is lowered
+  // the band follows the limit, at least 1 dA so that an exhausted budget stops the rise
+  double current_band = std::max(kCurrentBand * current_limit_, 1.0);
+  double headroom = std::min(getHeadroom(act_current, current_limit_, current_band),
+                             getHeadroom(act_temp, MAX_TEMP, kTempBand));
+  double ceiling  = act_rpm + headroom * max_step;
+  double target   = std::max(0.0, std::min<double>({output, ceiling, MAX_RPM}));
+
+  // integrate only while unconstrained, the integral would wind up otherwise
+  if (target == output) {
+    integral_ += error * dt;
   } else {
-    return act_rpm;
+    log_.DBG3("MOTOR", "rpm limited to %d, current %d, temperature %d",
+              static_cast<int>(target), act_current, act_temp);
   }
+  return std::lround(target);
 }
 
-int32_t RPM_Regulator::calculateOptimalRPM(int32_t act_velocity)
+double RPM_Regulator::getOptimalRPM(float velocity)
 {
-  int32_t opt_rpm = std::round(0.32047 * act_velocity*act_velocity +
-                                297.72578 * act_velocity + 1024.30824);
-  return opt_rpm;
+  double position = std::max(0.0, velocity / kTableStep);
+  size_t index    = static_cast<size_t>(position);
+  if (index + 1 >= table_.size()) return table_.back();
+  double fraction = position - index;
+  return table_[index] + fraction * (table_[index + 1] - table_[index]);
 }
 
-int32_t RPM_Regulator::step(int32_t opt_rpm, bool direction)
+double RPM_Regulator::calculateOptimalRPM(double act_velocity)
 {
-  if (direction) {
-    return std::round(opt_rpm*0.1);
-  } else {
-    return std::round(opt_rpm*0.05);
-  }
+  return 0.32047 * act_velocity*act_velocity + 297.72578 * act_velocity + 1024.30824;
+}
+
+double RPM_Regulator::getHeadroom(double value, double limit, double band)
+{
+  return std::max(-1.0, std::min(1.0, (limit - value) / band));
 }
 
 bool RPM_Regulator::getFailure()
@@ -24,8 +24,8 @@
 
 #define MAX_RPM 6000
 #define MAX_TEMP 150
-#define MAX_CURRENT 1500  // mA
 
+#include <cstdint>
 #include <cstdlib>
 #include <vector>
 #include "utils/system.hpp"
@@ -41,26 +41,59 @@ using motor_control::Controller;
 
 namespace motor_control {
 
+/**
+ * @brief Fixed-rate speed control of the motors. Every call of calculateRPM() is one control
+ * period of kPeriod. The target is the optimal rpm for the pod velocity, taken from a lookup
+ * table and approached at no more than kMaxRpmRate. Feed-forward of that reference is corrected
+ * by a PI controller on the rpm error. Current and temperature are soft limits: approaching them
+ * slows the rise of the target, exceeding them lowers it. Output only depends on the inputs
+ * and the previous calls, so a run can be replayed exactly.
+ */
 class RPM_Regulator {
  public:
+  static constexpr uint64_t kPeriod       = 5000;     // microseconds
+  static constexpr double   kProportional = 0.3;
+  static constexpr double   kIntegral     = 2.0;      // 1/s
+  static constexpr double   kMaxRpmRate   = 5000;     // rpm/s of the reference
+  static constexpr double   kMaxVelocity  = 100;      // m/s, end of the lookup table
+  static constexpr double   kTableStep    = 0.5;      // m/s between lookup table entries
+  static constexpr int32_t  kMaxCurrent   = 1500;     // dA, soft limit until one is set
+  static constexpr double   kCurrentBand  = 0.1;      // share of the current limit
+  static constexpr double   kTempBand     = 10;
+
   /*
   * @brief Construct a new rpm regulator object
   * @param log
   */
   explicit RPM_Regulator(Logger& log);
   /**
-   * @brief Calculate the optimal rpm based on criteria from all the motors
-   *        as well optimal values produced by simulations.
+   * @brief Run one control period and return the rpm the motors should be set to.
    *
-   * @param act_velocity - the actual velocity of the pod from navigation
+   * @param act_velocity - the actual velocity of the pod from navigation in m/s
    * @param act_rpm - average rpm of all the motors
-   * @param act_current - max current (mA) drawn out of all the motors
+   * @param act_current - max current (dA) of the high power packs
    * @param act_temp - max temperature out of all the motors
    * @return int32_t - the optimal rpm which the motors should be set to.
    */
-  int32_t calculateRPM(int32_t act_velocity, int32_t act_rpm,
+  int32_t calculateRPM(float act_velocity, int32_t act_rpm,
                       int32_t act_current, int32_t act_temp);
 
+  /**
+   * @brief Start again from act_rpm, e.g. when the motors are enabled
+   */
+  void reset(int32_t act_rpm);
+
+  /**
+   * @brief Move the soft limit on act_current, kMaxCurrent until set, e.g. to a CurrentBudget.
+   *        The band below it where the target rises more slowly scales with the limit.
+   */
+  void setCurrentLimit(int32_t limit);
+
+  /**
+   * @return rpm for velocity interpolated from the lookup table
+   */
+  double getOptimalRPM(float velocity);
+
   /**
    * @brief Get the Failure boolean
    *
@@ -71,24 +104,24 @@ class RPM_Regulator {
 
  private:
   /**
-   * @brief calculates the optimal rpm based off of the current velocity.
+   * @brief calculates the optimal rpm based off of the current velocity, used to fill the
+   *        lookup table.
    *
    * @param act_velocity
    * @return double - optimal rpm
    */
-  int32_t calculateOptimalRPM(int32_t act_velocity);
+  static double calculateOptimalRPM(double act_velocity);
 
   /**
-   * @brief calculate the step to increase or decrease the rpm by.
-   *
-   * @param opt_rpm - the optimal rpm for our current velocity
-   * @param direction - the direction that the step must go in: true for pos false for neg.
-   * @return int32_t - the step with which to increase the rpm
+   * @return how far the target may rise, 1 well below limit, 0 at it, down to -1 band beyond
    */
-  int32_t step(int32_t opt_rpm, bool direction);
+  static double getHeadroom(double value, double limit, double band);
 
   Logger& log_;
-  int32_t current_index;
+  vector<double> table_;
+  double reference_;    // rpm, follows the optimal rpm at kMaxRpmRate
+  double integral_;     // rpm seconds
+  double current_limit_;
   bool failure;
 };
 
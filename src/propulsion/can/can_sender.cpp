@@ -18,48 +18,143 @@
 
 #include "propulsion/can/can_sender.hpp"
 
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
 namespace hyped
 {
 namespace motor_control
 {
 CanSender::CanSender(Logger &log, uint8_t node_id) : log_(log),
                                                       node_id_(node_id),
-                                                      can_(Can::getInstance()),
-                                                      messageTimestamp(0)
+                                                      can_(Can::getMotorBus()),
+                                                      controller_(nullptr)
 {
-  isSending = false;
   can_.start();
 }
 
 CanSender::CanSender(ControllerInterface* controller, uint8_t node_id, Logger& log)
+  : CanSender(controller, node_id, log, Can::getMotorBus())
+{ /* EMPTY */ }
+
+CanSender::CanSender(ControllerInterface* controller, uint8_t node_id, Logger& log, Can& can)
   : log_(log),
     node_id_(node_id),
-    can_(Can::getInstance()),
-    controller_(controller),
-    messageTimestamp(0)
+    can_(can),
+    controller_(controller)
 {
-  isSending = false;
   can_.start();
 }
 
 bool CanSender::sendMessage(utils::io::can::Frame &message)
 {
   log_.INFO("MOTOR", "Sending Message");
-  can_.send(message);
-  isSending = true;
+  if (message.id != kSdoReceive + node_id_) {
+    // NMT and PDO messages are not confirmed
+    return can_.send(message);
+  }
+  return sendSdo(message, nullptr);
+}
 
-  timer.start();
-  messageTimestamp = timer.getTimeMicros();
+bool CanSender::sendSdo(const utils::io::can::Frame& request, utils::io::can::Frame* response,
+                        uint64_t timeout)
+{
+  std::vector<utils::io::can::Frame> responses;
+  if (!sendSdos({request}, &responses, 1, timeout)) return false;
+  if (response) *response = responses[0];
+  return true;
+}
+
+bool CanSender::sendSdos(const std::vector<utils::io::can::Frame>& requests,
+                         std::vector<utils::io::can::Frame>* responses, uint32_t window,
+                         uint64_t timeout, uint32_t retries)
+{
+  struct Transfer {
+    PendingSdo  pending;
+    uint32_t    attempts;
+    uint64_t    deadline;
+    bool        active;
+  };
+  std::vector<Transfer> transfers(requests.size());
+  size_t next      = 0;
+  size_t in_flight = 0;
+  size_t finished  = 0;
+  bool   answered  = true;
+  if (window < 1) window = 1;
 
-  while (isSending) {
-    if ((timer.getTimeMicros() - messageTimestamp) > TIMEOUT) {
-      // TODO(Iain): Test the latency and set the TIMEOUT to a reasonable value.
-      log_.ERR("MOTOR", "Sender timeout reached");
-      return false;
+  utils::concurrent::ScopedLock L(&pending_lock_);
+  while (finished < requests.size()) {
+    // requests are registered before sending, a fast response could otherwise find nobody
+    while (in_flight < window && next < requests.size()) {
+      Transfer& transfer = transfers[next];
+      transfer.pending  = {getSdoKey(requests[next]), false, {}};
+      transfer.attempts = 1;
+      transfer.deadline = Timer::getTimeMicros() + timeout;
+      transfer.active   = true;
+      pending_.push_back(&transfer.pending);
+      can_.send(requests[next]);
+      next++;
+      in_flight++;
     }
+
+    uint64_t now      = Timer::getTimeMicros();
+    uint64_t earliest = UINT64_MAX;
+    bool     progress = false;
+    for (size_t i = 0; i < next; i++) {
+      Transfer& transfer = transfers[i];
+      if (!transfer.active) continue;
+
+      PendingSdo& pending = transfer.pending;
+      if (!pending.done && now >= transfer.deadline && transfer.attempts <= retries) {
+        log_.DBG("MOTOR", "Controller %d: resending SDO 0x%04x sub %d", node_id_,
+                 pending.key >> 8, pending.key & 0xFF);
+        transfer.attempts++;
+        transfer.deadline = now + timeout;
+        can_.send(requests[i]);
+      }
+      if (!pending.done && now < transfer.deadline) {
+        earliest = std::min(earliest, transfer.deadline);
+        continue;
+      }
+
+      if (!pending.done) {
+        log_.ERR("MOTOR", "Controller %d: no response to SDO 0x%04x sub %d", node_id_,
+                 pending.key >> 8, pending.key & 0xFF);
+        answered = false;
+      } else if (pending.response.data[0] == kSdoAbort) {
+        log_.ERR("MOTOR", "Controller %d: SDO 0x%04x sub %d aborted with code "
+                 "0x%02x%02x%02x%02x", node_id_, pending.key >> 8, pending.key & 0xFF,
+                 pending.response.data[7], pending.response.data[6], pending.response.data[5],
+                 pending.response.data[4]);
+      }
+      removePending(&pending);
+      transfer.active = false;
+      in_flight--;
+      finished++;
+      progress = true;
+    }
+
+    if (!progress && in_flight > 0) response_cv_.waitFor(&pending_lock_, earliest - now);
   }
 
-  return true;
+  if (responses) {
+    responses->clear();
+    for (Transfer& transfer : transfers) {
+      responses->push_back(transfer.pending.response);    // id 0 if never answered
+    }
+  }
+  return answered;
+}
+
+void CanSender::removePending(PendingSdo* pending)
+{
+  pending_.erase(std::find(pending_.begin(), pending_.end(), pending));
+}
+
+uint32_t CanSender::getSdoKey(const utils::io::can::Frame& message)
+{
+  return (message.data[2] << 16) | (message.data[1] << 8) | message.data[3];
 }
 
 void CanSender::registerController()
@@ -69,20 +164,38 @@ void CanSender::registerController()
 
 void CanSender::processNewData(utils::io::can::Frame &message)
 {
-  isSending = false;
-
   uint32_t id = message.id;
   if (id == kEmgyTransmit + node_id_) {
     controller_->processEmergencyMessage(message);
   } else if (id == kSdoTransmit + node_id_) {
+    // the controller sees the response before the waiting sender wakes up
     controller_->processSdoMessage(message);
+
+    uint32_t key = getSdoKey(message);
+    utils::concurrent::ScopedLock L(&pending_lock_);
+    for (PendingSdo* pending : pending_) {
+      if (pending->key == key && !pending->done) {
+        pending->response = message;
+        pending->done     = true;
+        response_cv_.notifyAll();
+        break;
+      }
+    }
   } else if (id == kNmtTransmit + node_id_) {
     controller_->processNmtMessage(message);
+  } else if (isTransmitPdo(id)) {
+    controller_->processPdoMessage(message);
   } else {
     log_.ERR("MOTOR", "Controller %d: CAN message not recognised", node_id_);
   }
 }
 
+bool CanSender::isTransmitPdo(uint32_t id)
+{
+  return id == kPdo1Transmit + node_id_ || id == kPdo2Transmit + node_id_
+      || id == kPdo3Transmit + node_id_ || id == kPdo4Transmit + node_id_;
+}
+
 bool CanSender::hasId(uint32_t id, bool extended)
 {
   for (uint32_t cobId : canIds) {
@@ -94,9 +207,17 @@ bool CanSender::hasId(uint32_t id, bool extended)
   return false;
 }
 
+void CanSender::getIdRanges(std::vector<utils::io::can::IdRange>* ranges)
+{
+  for (uint32_t cobId : canIds) {
+    ranges->push_back({cobId + node_id_, cobId + node_id_, false});
+  }
+}
+
 bool CanSender::getIsSending()
 {
-  return isSending;
+  utils::concurrent::ScopedLock L(&pending_lock_);
+  return !pending_.empty();
 }
 }  // namespace motor_control
 }  // namespace hyped
@@ -21,8 +21,11 @@
 
 #include <atomic>
 #include <iostream>
+#include <vector>
 #include "utils/io/can.hpp"
 #include "utils/logger.hpp"
+#include "utils/concurrent/condition_variable.hpp"
+#include "utils/concurrent/lock.hpp"
 #include "utils/concurrent/thread.hpp"
 #include "propulsion/controller_interface.hpp"
 #include "sender_interface.hpp"
@@ -55,10 +58,41 @@ class CanSender : public CanProccesor, public SenderInterface
     CanSender(ControllerInterface* controller, uint8_t node_id, Logger& log_);
 
     /**
-       * @brief { Sends CAN messages }
+       * @brief { Same as above but talks to the controller over the given bus instead of the
+       * configured motor bus }
+       */
+    CanSender(ControllerInterface* controller, uint8_t node_id, Logger& log_, Can& can);
+
+    /**
+       * @brief { Sends CAN messages. SDO requests to this node block until the controller
+       * answered the same index and subindex or TIMEOUT passed, other messages return once
+       * queued }
        */
     bool sendMessage(utils::io::can::Frame &message) override;
 
+    /**
+       * @brief { Sends an SDO request and sleeps until the response with matching index and
+       * subindex arrives. The response is processed by the controller before this returns }
+       *
+       * @param response - output, optional, the matching response, may be an SDO abort
+       * @return false iff no matching response arrived within timeout microseconds
+       */
+    bool sendSdo(const utils::io::can::Frame& request, utils::io::can::Frame* response,
+                 uint64_t timeout = TIMEOUT);
+
+    /**
+       * @brief { Sends SDO requests in order, keeping up to window of them waiting for their
+       * response at the same time. A request without response after timeout microseconds is
+       * sent again, at most retries times }
+       *
+       * @param responses - output, optional, the response to every request, in the order of
+       * requests. Requests never answered get a frame with id 0
+       * @return false iff some request was not answered after all its retries
+       */
+    bool sendSdos(const std::vector<utils::io::can::Frame>& requests,
+                  std::vector<utils::io::can::Frame>* responses, uint32_t window,
+                  uint64_t timeout = TIMEOUT, uint32_t retries = 0);
+
     /**
        * @brief { Registers the controller to process incoming CAN messages }
        */
@@ -74,19 +108,46 @@ class CanSender : public CanProccesor, public SenderInterface
        */
     bool hasId(uint32_t id, bool extended) override;
 
+    /**
+       * @brief { Declares the CANopen ids of this node to the CAN dispatcher }
+       */
+    void getIdRanges(std::vector<utils::io::can::IdRange>* ranges) override;
+
     /**
        * @brief { Return if the can_sender is sending a CAN message right now }
        */
     bool getIsSending() override;
 
   private:
+    // an SDO request waiting for its response
+    struct PendingSdo {
+      uint32_t key;
+      bool done;
+      utils::io::can::Frame response;
+    };
+
+    /**
+       * @return { index and subindex of an SDO request or response, as one key }
+       */
+    static uint32_t getSdoKey(const utils::io::can::Frame& message);
+
+    /**
+       * @brief { Removes a request from pending_, pending_lock_ must be held }
+       */
+    void removePending(PendingSdo* pending);
+
+    /**
+       * @brief { True for the four transmit PDOs of this node }
+       */
+    bool isTransmitPdo(uint32_t id);
+
     Logger& log_;
     uint8_t node_id_;
     Can &can_;
-    std::atomic<bool> isSending;
     ControllerInterface *controller_;
-    Timer timer;
-    uint64_t messageTimestamp;
+    std::vector<PendingSdo*> pending_;   // oldest first
+    utils::concurrent::Lock pending_lock_;
+    utils::concurrent::ConditionVariable response_cv_;
 
     const uint32_t kEmgyTransmit          = 0x80;
     const uint32_t kSdoTransmit           = 0x580;
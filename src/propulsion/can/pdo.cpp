@@ -0,0 +1,108 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Transmit PDO mapping of the motor controllers
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "propulsion/can/pdo.hpp"
+
+#include <vector>
+
+namespace hyped
+{
+namespace motor_control
+{
+namespace pdo
+{
+
+namespace
+{
+// expedited SDO download command bytes by size of the value
+constexpr uint8_t kWriteOneByte   = 0x2F;
+constexpr uint8_t kWriteTwoBytes  = 0x2B;
+constexpr uint8_t kWriteFourBytes = 0x23;
+
+void addWrite(uint8_t node_id, uint8_t command, uint16_t index, uint8_t sub_index,
+              uint32_t value, std::vector<utils::io::can::Frame>* requests)
+{
+  utils::io::can::Frame frame = {};
+  frame.id       = kSdoReceive + node_id;
+  frame.extended = false;
+  frame.len      = 8;
+  frame.data[0]  = command;
+  frame.data[1]  = index & 0xFF;
+  frame.data[2]  = index >> 8;
+  frame.data[3]  = sub_index;
+  for (int i = 0; i < 4; i++) {
+    frame.data[4 + i] = (value >> (8 * i)) & 0xFF;
+  }
+  requests->push_back(frame);
+}
+
+int getLength(const Mapping& mapping)
+{
+  int bits = 0;
+  for (int i = 0; i < mapping.count; i++) bits += mapping.objects[i].bits;
+  return bits / 8;
+}
+}  // namespace
+
+void getConfiguration(uint8_t node_id, uint16_t period,
+                      std::vector<utils::io::can::Frame>* requests)
+{
+  for (const Mapping& mapping : kMappings) {
+    uint16_t communication = kTransmitCommunication + mapping.number;
+    uint16_t map           = kTransmitMapping + mapping.number;
+    uint32_t cob_id        = getCobId(mapping.number, node_id);
+
+    addWrite(node_id, kWriteFourBytes, communication, 1, cob_id | kCobIdInvalid, requests);
+    addWrite(node_id, kWriteOneByte, communication, 2, kAsynchronous, requests);
+    addWrite(node_id, kWriteTwoBytes, communication, 5, period * mapping.period_factor,
+             requests);
+
+    // the number of entries is cleared while they are written
+    addWrite(node_id, kWriteOneByte, map, 0, 0, requests);
+    for (int i = 0; i < mapping.count; i++) {
+      const Object& object = mapping.objects[i];
+      uint32_t entry = (object.index << 16) | (object.sub_index << 8) | object.bits;
+      addWrite(node_id, kWriteFourBytes, map, i + 1, entry, requests);
+    }
+    addWrite(node_id, kWriteOneByte, map, 0, mapping.count, requests);
+
+    addWrite(node_id, kWriteFourBytes, communication, 1, cob_id, requests);
+  }
+}
+
+int getMapping(const utils::io::can::Frame& message, uint8_t node_id)
+{
+  for (int i = 0; i < kNumMappings; i++) {
+    if (message.id != getCobId(kMappings[i].number, node_id)) continue;
+    if (message.len < getLength(kMappings[i])) return -1;
+    return i;
+  }
+  return -1;
+}
+
+uint32_t readObject(const uint8_t* data, int offset, const Object& object)
+{
+  uint32_t value = 0;
+  for (int i = 0; i < object.bits / 8; i++) {
+    value |= static_cast<uint32_t>(data[offset + i]) << (8 * i);
+  }
+  return value;
+}
+
+}  // namespace pdo
+}  // namespace motor_control
+}  // namespace hyped
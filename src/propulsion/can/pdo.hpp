@@ -0,0 +1,99 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Transmit PDO mapping of the motor controllers. Actual velocity and torque, motor and
+ * controller temperature are broadcast cyclically by the controller, so reading them does not
+ * take an SDO round trip. getConfiguration() gives the SDO writes setting up the mapping,
+ * getMapping() and readObject() split a received PDO back into the mapped objects.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef PROPULSION_CAN_PDO_HPP_
+#define PROPULSION_CAN_PDO_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "utils/io/can.hpp"
+#include "sender_interface.hpp"
+
+namespace hyped
+{
+namespace motor_control
+{
+namespace pdo
+{
+
+constexpr uint16_t kTransmitCommunication = 0x1800;   // TPDO communication parameters
+constexpr uint16_t kTransmitMapping       = 0x1A00;   // TPDO mapping parameters
+constexpr uint32_t kCobIdInvalid          = 0x80000000;
+constexpr uint8_t  kAsynchronous          = 0xFE;     // sent whenever the event timer expires
+constexpr int      kMaxObjects            = 4;
+
+// object dictionary entry carried by a PDO
+struct Object {
+  uint16_t index;
+  uint8_t  sub_index;
+  uint8_t  bits;
+};
+
+struct Mapping {
+  uint8_t   number;           // 0 for TPDO1
+  uint16_t  period_factor;    // event timer in multiples of the configured period
+  uint8_t   count;
+  Object    objects[kMaxObjects];
+};
+
+constexpr int kNumMappings = 2;
+constexpr Mapping kMappings[kNumMappings] = {
+  // velocity actual value, torque actual value
+  {0, 1,  2, {{0x606C, 0x00, 32}, {0x6077, 0x00, 16}}},
+  // motor temperature, controller temperature, these change slowly
+  {1, 10, 2, {{0x2025, 0x00, 8}, {0x2026, 0x01, 8}}},
+};
+
+/**
+ * @brief { COB-ID node sends TPDO number with }
+ */
+constexpr uint32_t getCobId(uint8_t number, uint8_t node_id)
+{
+  return kPdo1Transmit + 0x100 * number + node_id;
+}
+
+/**
+ * @brief { Appends the SDO writes mapping all kMappings of node. Each TPDO is disabled while
+ * its mapping changes, as CiA 301 requires }
+ *
+ * @param period - milliseconds between two TPDO1, the event timer of the others is a multiple
+ */
+void getConfiguration(uint8_t node_id, uint16_t period,
+                      std::vector<utils::io::can::Frame>* requests);
+
+/**
+ * @return index into kMappings of the TPDO message is, -1 if it is none of them or
+ * shorter than the mapped objects
+ */
+int getMapping(const utils::io::can::Frame& message, uint8_t node_id);
+
+/**
+ * @brief { Little endian value of object at offset bytes into data. Narrowing it to the type
+ * of the object restores the sign }
+ */
+uint32_t readObject(const uint8_t* data, int offset, const Object& object);
+
+}  // namespace pdo
+}  // namespace motor_control
+}  // namespace hyped
+
+#endif  // PROPULSION_CAN_PDO_HPP_
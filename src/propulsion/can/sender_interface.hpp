@@ -42,6 +42,9 @@ constexpr uint32_t kPdo3Receive = 0x400;
 constexpr uint32_t kPdo4Transmit = 0x480;
 constexpr uint32_t kPdo4Receive = 0x500;
 
+// SDO command byte of a response aborting the transfer
+constexpr uint8_t kSdoAbort = 0x80;
+
 constexpr uint32_t canIds[13] {0x80, 0x600, 0x580, 0x000, 0x700,
                               0x180, 0x200, 0x280, 0x300, 0x380,
                               0x400, 0x480, 0x500};
@@ -21,6 +21,13 @@
 
 #include "propulsion/controller.hpp"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "propulsion/controller_messages.hpp"
+#include "utils/config.hpp"
+
 namespace hyped {
 namespace motor_control {
 
@@ -45,20 +52,41 @@ Controller::Controller(Logger& log, uint8_t id)
   nmt_message_.extended   = false;
   nmt_message_.len        = 2;
 
+  // values are polled by SDO until the first PDO arrives
+  int period = utils::System::getSystem().config->motor_control.pdo_period;
+  for (int i = 0; i < pdo::kNumMappings; i++) {
+    pdo_timestamps_[i] = 0;
+    pdo_timeouts_[i]   = kPdoMissedPeriods * period * pdo::kMappings[i].period_factor * 1000;
+  }
+
   // Initialse arrays of message data:
-  FileReader::readFileData(configMsgs_, 24, kConfigMsgFile);
-  FileReader::readFileData(enterOpMsgs_, 4, kEnterOpMsgFile);
-  FileReader::readFileData(enterPreOpMsg_, 1,  kEnterPreOpMsgFile);
-  FileReader::readFileData(checkStateMsg_, 1, kCheckStateMsgFile);
-  FileReader::readFileData(sendTargetVelMsg, 1, kSendTargetVelMsgFile);
-  FileReader::readFileData(sendTargetTorqMsg, 1, kSendTargetTorqMsgFile);
-  FileReader::readFileData(updateActualVelMsg, 1, kUpdateActualVelMsgFile);
-  FileReader::readFileData(updateActualTorqMsg, 1, kUpdateActualTorqMsgFile);
-  FileReader::readFileData(quickStopMsg, 1, kQuickStopMsgFile);
-  FileReader::readFileData(healthCheckMsgs, 2, kHealthCheckMsgFile);
-  FileReader::readFileData(updateMotorTempMsg, 1, kUpdateMotorTempFile);
-  FileReader::readFileData(updateContrTempMsg, 1, kUpdateContrTempFile);
-  FileReader::readFileData(autoAlignMsg, 1, kAutoAlignMsgFile);
+  loadMessages(configMsgs_, messages::kConfigure, kConfigMsgFile);
+  loadMessages(enterOpMsgs_, messages::kEnterOperational, kEnterOpMsgFile);
+  loadMessages(enterPreOpMsg_, messages::kEnterPreOperational, kEnterPreOpMsgFile);
+  loadMessages(checkStateMsg_, messages::kCheckState, kCheckStateMsgFile);
+  loadMessages(sendTargetVelMsg, messages::kSendTargetVelocity, kSendTargetVelMsgFile);
+  loadMessages(sendTargetTorqMsg, messages::kSendTargetTorque, kSendTargetTorqMsgFile);
+  loadMessages(updateActualVelMsg, messages::kUpdateActualVelocity, kUpdateActualVelMsgFile);
+  loadMessages(updateActualTorqMsg, messages::kUpdateActualTorque, kUpdateActualTorqMsgFile);
+  loadMessages(quickStopMsg, messages::kQuickStop, kQuickStopMsgFile);
+  loadMessages(healthCheckMsgs, messages::kHealthCheck, kHealthCheckMsgFile);
+  loadMessages(updateMotorTempMsg, messages::kUpdateMotorTemp, kUpdateMotorTempFile);
+  loadMessages(updateContrTempMsg, messages::kUpdateContrTemp, kUpdateContrTempFile);
+  loadMessages(autoAlignMsg, messages::kAutoAlign, kAutoAlignMsgFile);
+}
+
+template<int N>
+void Controller::loadMessages(ControllerMessage (&messages)[N],
+                              const ControllerMessage (&table)[N], const char* file)
+{
+  const std::string& directory = utils::System::getSystem().config->motor_control.message_files;
+  if (!directory.empty()) {
+    std::string path = directory + "/" + file;
+    if (FileReader::readFileData(messages, N, path.c_str())) return;
+    log_.ERR("MOTOR", "Controller %d: using built-in messages instead of %s", node_id_,
+             path.c_str());
+  }
+  std::copy(table, table + N, messages);
 }
 
 bool Controller::sendControllerMessage(ControllerMessage message_template)
@@ -77,6 +105,16 @@ bool Controller::sendControllerMessage(ControllerMessage message_template)
   return false;
 }
 
+void Controller::addRequest(const ControllerMessage& message_template,
+                            std::vector<utils::io::can::Frame>* requests)
+{
+  requests->push_back(sdo_message_);
+  for (int i = 0; i < message_template.len; i++) {
+    requests->back().data[i] = message_template.message_data[i];
+  }
+  log_.DBG1("MOTOR", message_template.logger_output, node_id_);
+}
+
 void Controller::registerController()
 {
   sender.registerController();
@@ -85,9 +123,31 @@ void Controller::registerController()
 void Controller::configure()
 {
   log_.INFO("MOTOR", "Controller %d: Configuring...", node_id_);
-  for (int i = 0; i < 24; i++) {
-    if (sendControllerMessage(configMsgs_[i])) return;
-    Thread::sleep(100);
+  std::vector<utils::io::can::Frame> requests;
+  for (int i = 0; i < 24; i++) addRequest(configMsgs_[i], &requests);
+
+  // have actual values and temperatures broadcast instead of polling them
+  utils::Config::MotorControl& config = utils::System::getSystem().config->motor_control;
+  if (config.pdo_period > 0) {
+    log_.DBG1("MOTOR", "Controller %d: Mapping transmit PDOs every %d ms", node_id_,
+              config.pdo_period);
+    pdo::getConfiguration(node_id_, config.pdo_period, &requests);
+  }
+
+  // with a window above 1 the controller works through requests while further ones are on the bus
+  std::vector<utils::io::can::Frame> responses;
+  if (!sender.sendSdos(requests, &responses, config.sdo_window, config.sdo_timeout,
+                       config.sdo_retries)) {
+    log_.ERR("MOTOR", "Controller %d: No response from controller", node_id_);
+    throwCriticalFailure();
+    return;
+  }
+  for (utils::io::can::Frame& response : responses) {
+    if (response.data[0] == kSdoAbort) {
+      log_.ERR("MOTOR", "Controller %d: Configuration rejected", node_id_);
+      throwCriticalFailure();
+      return;
+    }
   }
   log_.INFO("MOTOR", "Controller %d: Configured.", node_id_);
 }
@@ -174,12 +234,14 @@ void Controller::sendTargetTorque(int16_t target_torque)
 void Controller::updateActualVelocity()
 {
   // Check actual velocity in object dictionary
+  if (isStreaming(0)) return;
   if (sendControllerMessage(updateActualVelMsg[0])) return;
 }
 
 void Controller::updateActualTorque()
 {
   // Check actual torque in object dictionary
+  if (isStreaming(0)) return;
   if (sendControllerMessage(updateActualTorqMsg[0])) return;
 }
 
@@ -201,12 +263,29 @@ void Controller::healthCheck()
 void Controller::updateMotorTemp()
 {
   // Check motor temp in object dictionary
+  if (isStreaming(1)) return;
   if (sendControllerMessage(updateMotorTempMsg[0])) return;
 }
 
+void Controller::updateActualValues()
+{
+  std::vector<utils::io::can::Frame> requests;
+  if (!isStreaming(0)) addRequest(updateActualVelMsg[0], &requests);
+  if (!isStreaming(1)) addRequest(updateMotorTempMsg[0], &requests);
+  if (requests.empty()) return;
+
+  utils::Config::MotorControl& config = utils::System::getSystem().config->motor_control;
+  if (!sender.sendSdos(requests, nullptr, config.sdo_window, config.sdo_timeout,
+                       config.sdo_retries)) {
+    log_.ERR("MOTOR", "Controller %d: No response from controller", node_id_);
+    throwCriticalFailure();
+  }
+}
+
 void Controller::updateControllerTemp()
 {
   // Check controller temp in object dictionary
+  if (isStreaming(1)) return;
   if (sendControllerMessage(updateContrTempMsg[0])) return;
 }
 
@@ -513,30 +592,12 @@ void Controller::processSdoMessage(utils::io::can::Frame& message)
   uint8_t index_2   = message.data[2];
   uint8_t sub_index = message.data[3];
 
-  // Process actual velocity
-  if (index_1 == 0x6C && index_2 == 0x60) {
-    actual_velocity_ =  ((int32_t) message.data[7]) << 24
-                      | ((int32_t) message.data[6]) << 16
-                      | ((int32_t) message.data[5]) << 8
-                      | message.data[4];
-    return;
-  }
-
-  // Process actual torque
-  if (index_1 == 0x77 && index_2 == 0x60) {
-    actual_torque_   = ((int16_t) message.data[5]) << 8 | message.data[4];
-    return;
-  }
-
-  // Process motor temperature
-  if (index_1 == 0x25 && index_2 == 0x20) {
-    motor_temperature_ = message.data[4];
-  }
-
-  // Process controller temperature
-  if (index_1 == 0x26 && index_2 == 0x20 && sub_index == 0x01) {
-    controller_temperature_ = message.data[4];
-  }
+  // Process actual velocity, torque and temperatures
+  uint32_t value =  ((uint32_t) message.data[7]) << 24
+                  | ((uint32_t) message.data[6]) << 16
+                  | ((uint32_t) message.data[5]) << 8
+                  | message.data[4];
+  if (storeObject((index_2 << 8) | index_1, sub_index, value)) return;
 
   // Process motor current TODO(iain): find register to process and correct types
 
@@ -737,6 +798,50 @@ void Controller::processNmtMessage(utils::io::can::Frame& message)
   }
 }
 
+void Controller::processPdoMessage(utils::io::can::Frame& message)
+{
+  int mapping = pdo::getMapping(message, node_id_);
+  if (mapping < 0) {
+    log_.DBG2("MOTOR", "Controller %d: PDO 0x%x not mapped", node_id_, message.id);
+    return;
+  }
+
+  const pdo::Mapping& entries = pdo::kMappings[mapping];
+  int offset = 0;
+  for (int i = 0; i < entries.count; i++) {
+    const pdo::Object& object = entries.objects[i];
+    storeObject(object.index, object.sub_index, pdo::readObject(message.data, offset, object));
+    offset += object.bits / 8;
+  }
+  pdo_timestamps_[mapping] = utils::Timer::getTimeMicros();
+}
+
+bool Controller::storeObject(uint16_t index, uint8_t sub_index, uint32_t value)
+{
+  switch (index) {
+    case 0x606C:    // velocity actual value
+      actual_velocity_ = static_cast<int32_t>(value);
+      return true;
+    case 0x6077:    // torque actual value
+      actual_torque_ = static_cast<int16_t>(value);
+      return true;
+    case 0x2025:    // motor temperature
+      motor_temperature_ = static_cast<uint8_t>(value);
+      return true;
+    case 0x2026:    // controller temperature
+      if (sub_index != 0x01) return false;
+      controller_temperature_ = static_cast<uint8_t>(value);
+      return true;
+  }
+  return false;
+}
+
+bool Controller::isStreaming(int mapping)
+{
+  uint64_t timestamp = pdo_timestamps_[mapping];
+  return timestamp && utils::Timer::getTimeMicros() - timestamp <= pdo_timeouts_[mapping];
+}
+
 int32_t Controller::getVelocity()
 {
   return actual_velocity_;
@@ -23,10 +23,12 @@
 #define PROPULSION_CONTROLLER_HPP_
 
 #include <atomic>
+#include <vector>
 
 #include "propulsion/controller_interface.hpp"
 #include "propulsion/file_reader.hpp"
 #include "propulsion/can/can_sender.hpp"
+#include "propulsion/can/pdo.hpp"
 #include "data/data.hpp"
 #include "utils/timer.hpp"
 #include "utils/logger.hpp"
@@ -88,11 +90,12 @@ class Controller : public ControllerInterface {
   void sendTargetTorque(int16_t target_torque);
   /**
    * @brief Send a request to the motor controller to get the actual velocity.
-   *
+   *        Does nothing while the velocity arrives by PDO.
    */
   void updateActualVelocity() override;
   /**
-   * @brief Send a request to the motor controller to get the actual velocity
+   * @brief Send a request to the motor controller to get the actual torque.
+   *        Does nothing while the torque arrives by PDO.
    */
   void updateActualTorque();
   /**
@@ -129,11 +132,16 @@ class Controller : public ControllerInterface {
    */
   void setFailure(bool failure);
   /**
-   * @brief Request the motor temperature from the controller
+   * @brief Request the motor temperature from the controller, unless it arrives by PDO
    */
   void updateMotorTemp() override;
   /**
-   * @brief Request the controller temperature from the controller
+   * @brief Request actual velocity and motor temperature in one exchange, both requests are on
+   *        the bus at the same time. Skips what arrives by PDO.
+   */
+  void updateActualValues() override;
+  /**
+   * @brief Request the controller temperature from the controller, unless it arrives by PDO
    */
   void updateControllerTemp();
   /**
@@ -164,6 +172,11 @@ class Controller : public ControllerInterface {
    * @param message
    */
   void processNmtMessage(utils::io::can::Frame& message) override;
+  /**
+   * @brief Called by processNewData if one of the mapped transmit PDOs is detected
+   * @param message CAN message to process
+   */
+  void processPdoMessage(utils::io::can::Frame& message) override;
   /*
    * @brief { Sends state transition message to controller, leaving sufficient time for
    *          controller to change state. If state does not change, throw critical failure }
@@ -186,6 +199,11 @@ class Controller : public ControllerInterface {
    * @param len
    */
   bool sendControllerMessage(ControllerMessage message_template);
+  /**
+   * @brief append an SDO request built from message_template, for sending several at once
+   */
+  void addRequest(const ControllerMessage& message_template,
+                  std::vector<utils::io::can::Frame>* requests);
   /*
    * @brief Sends a CAN frame but waits for a reply
    */
@@ -194,6 +212,23 @@ class Controller : public ControllerInterface {
    * @brief set critical failure flag to true and write failure to data structure.
    */
   void throwCriticalFailure();
+  /**
+   * @brief fill messages from the generated table, or from file if the development override
+   *        MotorControl MessageFiles is set.
+   */
+  template<int N>
+  void loadMessages(ControllerMessage (&messages)[N], const ControllerMessage (&table)[N],
+                    const char* file);
+  /**
+   * @brief store the value of an object dictionary entry read by SDO or PDO
+   * @return true iff the entry is one of the actual values kept by the controller
+   */
+  bool storeObject(uint16_t index, uint8_t sub_index, uint32_t value);
+  /**
+   * @brief true iff the PDO of pdo::kMappings[mapping] arrived recently, its values are then
+   *        up to date without asking for them
+   */
+  bool isStreaming(int mapping);
 
   Logger&                   log_;
   data::Data&               data_;
@@ -205,27 +240,32 @@ class Controller : public ControllerInterface {
   atomic<int16_t>           actual_torque_;
   atomic<uint8_t>           motor_temperature_;
   atomic<uint8_t>           controller_temperature_;
+  atomic<uint64_t>          pdo_timestamps_[pdo::kNumMappings];   // 0 if none arrived yet
+  uint64_t                  pdo_timeouts_[pdo::kNumMappings];     // microseconds
   CanSender                 sender;
   Frame             sdo_message_;
   Frame             nmt_message_;
 
   // Network management CAN commands:
   const uint8_t     kNmtOperational        = 0x01;
+  // PDO periods that may be missed before values are requested by SDO again
+  const uint64_t    kPdoMissedPeriods      = 3;
 
-  // Paths to the different files of message data.
-  const char* kConfigMsgFile = "data/in/controllerConfigFiles/configure.txt";
-  const char* kEnterOpMsgFile = "data/in/controllerConfigFiles/enter_operational.txt";
-  const char* kEnterPreOpMsgFile = "data/in/controllerConfigFiles/enter_preOperational.txt";
-  const char* kCheckStateMsgFile = "data/in/controllerConfigFiles/check_state.txt";
-  const char* kSendTargetVelMsgFile = "data/in/controllerConfigFiles/send_target_velocity.txt";
-  const char* kSendTargetTorqMsgFile = "data/in/controllerConfigFiles/send_target_torque.txt";
-  const char* kUpdateActualVelMsgFile = "data/in/controllerConfigFiles/update_actual_velocity.txt";
-  const char* kUpdateActualTorqMsgFile = "data/in/controllerConfigFiles/update_actual_torque.txt";
-  const char* kQuickStopMsgFile = "data/in/controllerConfigFiles/quick_stop.txt";
-  const char* kHealthCheckMsgFile = "data/in/controllerConfigFiles/health_check.txt";
-  const char* kUpdateMotorTempFile = "data/in/controllerConfigFiles/update_motor_temp.txt";
-  const char* kUpdateContrTempFile = "data/in/controllerConfigFiles/update_contr_temp.txt";
-  const char* kAutoAlignMsgFile = "data/in/controllerConfigFiles/auto_align.txt";
+  // Files of message data, only read if MotorControl MessageFiles is configured. By default the
+  // messages come from the tables generated from data/in/controllerConfigFiles at build time.
+  const char* kConfigMsgFile = "configure.txt";
+  const char* kEnterOpMsgFile = "enter_operational.txt";
+  const char* kEnterPreOpMsgFile = "enter_preOperational.txt";
+  const char* kCheckStateMsgFile = "check_state.txt";
+  const char* kSendTargetVelMsgFile = "send_target_velocity.txt";
+  const char* kSendTargetTorqMsgFile = "send_target_torque.txt";
+  const char* kUpdateActualVelMsgFile = "update_actual_velocity.txt";
+  const char* kUpdateActualTorqMsgFile = "update_actual_torque.txt";
+  const char* kQuickStopMsgFile = "quick_stop.txt";
+  const char* kHealthCheckMsgFile = "health_check.txt";
+  const char* kUpdateMotorTempFile = "update_motor_temp.txt";
+  const char* kUpdateContrTempFile = "update_contr_temp.txt";
+  const char* kAutoAlignMsgFile = "auto_align.txt";
 
  public:
   // Arrays of messages sent to controller (see config files for details about message contents)
@@ -41,9 +41,10 @@ enum ControllerState {
   kFault,
 };
 
+// An aggregate so that the message tables generated at build time can be constexpr
 struct ControllerMessage {
   uint8_t       message_data[8];
-  int           len = 8;
+  int           len;
   char   logger_output[250];
 };
 
@@ -62,12 +63,21 @@ class ControllerInterface {
   virtual bool getFailure() = 0;
   virtual void updateMotorTemp() = 0;
   virtual uint8_t getMotorTemp() = 0;
+  // refreshes actual velocity and motor temperature together, by default one after the other
+  virtual void updateActualValues()
+  {
+    updateActualVelocity();
+    updateMotorTemp();
+  }
   virtual ControllerState getControllerState() = 0;
   virtual void processEmergencyMessage(utils::io::can::Frame& message) = 0;
   virtual void processErrorMessage(uint16_t error_message) = 0;
   virtual void processSdoMessage(utils::io::can::Frame& message) = 0;
   virtual void processNmtMessage(utils::io::can::Frame& message) = 0;
+  virtual void processPdoMessage(utils::io::can::Frame& message) = 0;
   virtual void requestStateTransition(utils::io::can::Frame& message, ControllerState state) = 0;
+
+  virtual ~ControllerInterface() {}
 };
 }  // namespace motor_control
 }  // namespace hyped
@@ -0,0 +1,149 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Current budget of the high power batteries for the motors
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "propulsion/current_budget.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "propulsion/RPM_regulator.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+constexpr int    CurrentBudget::kNumPacks;
+constexpr double CurrentBudget::kMinPackVoltage;
+constexpr double CurrentBudget::kMaxPackCurrent;
+constexpr double CurrentBudget::kMaxPackTemperature;
+constexpr double CurrentBudget::kMinCellVoltage;
+constexpr double CurrentBudget::kMargin;
+constexpr double CurrentBudget::kTemperatureBand;
+constexpr double CurrentBudget::kHorizon;
+constexpr double CurrentBudget::kDefaultResistance;
+constexpr double CurrentBudget::kMinCurrentStep;
+constexpr double CurrentBudget::kFilterGain;
+
+CurrentBudget::CurrentBudget()
+    : time_(0),
+      worst_(0)
+{
+  for (Pack& pack : packs_) {
+    pack.reported   = false;
+    pack.voltage    = 0;
+    pack.current    = 0;
+    pack.time       = 0;
+    pack.resistance = kDefaultResistance;
+    pack.slope      = 0;
+    pack.limit      = kMaxPackCurrent * (1 - kMargin);
+  }
+}
+
+void CurrentBudget::update(const data::Batteries& batteries, uint64_t time)
+{
+  time_ = time;
+  for (int i = 0; i < kNumPacks; i++) {
+    const data::BatteryData& battery = batteries.high_power_batteries[i];
+    Pack& pack = packs_[i];
+    bool changed = battery.voltage != pack.voltage || battery.current != pack.current;
+    if (pack.reported && changed && time > pack.time) {
+      double current_step = (battery.current - pack.current) / 10.0;
+      double voltage_step = (battery.voltage - pack.voltage) / 10.0;
+      double slope = current_step / ((time - pack.time) / 1e6);
+      pack.slope += kFilterGain * (slope - pack.slope);
+
+      // the pack sags in proportion to the current drawn, steps too small are mostly noise
+      if (std::fabs(current_step) >= kMinCurrentStep) {
+        double resistance = -voltage_step / current_step;
+        if (resistance > 0 && resistance < 10 * kDefaultResistance) {
+          pack.resistance += kFilterGain * (resistance - pack.resistance);
+        }
+      }
+    }
+    if (!pack.reported || changed) {
+      pack.reported = true;
+      pack.voltage  = battery.voltage;
+      pack.current  = battery.current;
+      pack.time     = time;
+    }
+    pack.limit = calculateLimit(pack, battery);
+  }
+
+  worst_ = 0;
+  for (int i = 1; i < kNumPacks; i++) {
+    double headroom = packs_[i].limit - getPredictedCurrent(packs_[i]);
+    if (headroom < packs_[worst_].limit - getPredictedCurrent(packs_[worst_])) worst_ = i;
+  }
+}
+
+double CurrentBudget::calculateLimit(const Pack& pack, const data::BatteryData& battery)
+{
+  double current = pack.current / 10.0;
+  double limit   = kMaxPackCurrent * (1 - kMargin);
+
+  // the voltage without load, less the sag at the limit, must stay above the minimum
+  double open_circuit = pack.voltage / 10.0 + current * pack.resistance;
+  double min_voltage  = kMinPackVoltage * (1 + kMargin);
+  limit = std::min(limit, (open_circuit - min_voltage) / pack.resistance);
+
+  // the weakest cell takes its share of the sag, the BMS reports 0 if it has no cell data
+  if (battery.low_voltage_cell > 0) {
+    double cell_resistance   = pack.resistance / data::BatteryData::kNumCells;
+    double cell_open_circuit = battery.low_voltage_cell / 1000.0 + current * cell_resistance;
+    limit = std::min(limit, (cell_open_circuit - kMinCellVoltage) / cell_resistance);
+  }
+
+  // hot packs get less, at the temperature limit nothing
+  double temperature = std::max(battery.high_temperature, battery.average_temperature);
+  double derating    = (kMaxPackTemperature - temperature) / kTemperatureBand;
+  limit *= std::max(0.0, std::min(1.0, derating));
+  return std::max(0.0, limit);
+}
+
+double CurrentBudget::getPredictedCurrent(const Pack& pack) const
+{
+  // only a rising current is extrapolated, a falling one is taken as it was reported. An
+  // unchanged report cannot be told from a missing one, so the age counts up to one period.
+  double age = time_ > pack.time ? (time_ - pack.time) / 1e6 : 0;
+  age = std::min(age, kHorizon);
+  return pack.current / 10.0 + std::max(0.0, pack.slope) * (age + kHorizon);
+}
+
+int32_t CurrentBudget::getPredictedCurrent() const
+{
+  return std::lround(getPredictedCurrent(packs_[worst_]) * 10);
+}
+
+int32_t CurrentBudget::getCurrentLimit() const
+{
+  return std::lround(packs_[worst_].limit * 10);
+}
+
+int32_t CurrentBudget::getMaxRpm(int32_t act_rpm) const
+{
+  const Pack& pack = packs_[worst_];
+  double band      = kMaxPackCurrent * kMargin;
+  double headroom  = (pack.limit - getPredictedCurrent(pack)) / band;
+  double max_step  = RPM_Regulator::kMaxRpmRate * RPM_Regulator::kPeriod / 1e6;
+  return std::lround(act_rpm + std::max(-1.0, std::min(1.0, headroom)) * max_step);
+}
+
+double CurrentBudget::getResistance(int pack) const
+{
+  return packs_[pack].resistance;
+}
+
+}}  // namespace hyped::motor_control
@@ -0,0 +1,103 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Current budget of the high power batteries for the motors. The BMS reports only a few times a
+ * second, so reacting to the reported current lets it overshoot before the target is lowered.
+ * The budget instead estimates the internal resistance of every pack from the reported voltage
+ * and current, predicts the current and the sag of pack and cells at the next report, and keeps
+ * the packs clear of the limits BmsManager::batteriesInRange checks. The motor targets are
+ * capped so that the predicted current stays within the budget.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef PROPULSION_CURRENT_BUDGET_HPP_
+#define PROPULSION_CURRENT_BUDGET_HPP_
+
+#include <cstdint>
+
+#include "data/data.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+class CurrentBudget {
+ public:
+  static constexpr int kNumPacks = data::Batteries::kNumHPBatteries;
+
+  // limits of BmsManager::batteriesInRange for a high power pack
+  static constexpr double kMinPackVoltage     = data::Batteries::kMinHPVoltage / 10.0;  // V
+  static constexpr double kMaxPackCurrent     = data::Batteries::kMaxHPCurrent / 10.0;  // A
+  static constexpr double kMaxPackTemperature = data::Batteries::kMaxHPTemperature;     // C
+
+  static constexpr double kMinCellVoltage     = 3.0;      // V, below it cells are damaged
+  static constexpr double kMargin             = 0.1;      // share of the limits kept in reserve
+  static constexpr double kTemperatureBand    = 10;       // C below the limit the budget shrinks
+  static constexpr double kHorizon            = 0.25;     // s ahead of a report, one BMS period
+  static constexpr double kDefaultResistance  = 0.05;     // ohm of a pack until estimated
+  static constexpr double kMinCurrentStep     = 10;       // A between reports to estimate from
+  static constexpr double kFilterGain         = 0.2;      // weight of a new estimate
+
+  CurrentBudget();
+
+  /**
+   * @brief Take in the battery data of this control cycle. A new voltage and current updates
+   * the estimates, a repeated one only ages.
+   * @param time - microseconds, any monotonic clock
+   */
+  void update(const data::Batteries& batteries, uint64_t time);
+
+  /**
+   * @return current of the most loaded pack expected at the next report, in dA like the BMS
+   */
+  int32_t getPredictedCurrent() const;
+
+  /**
+   * @return current the most loaded pack may supply, in dA like the BMS
+   */
+  int32_t getCurrentLimit() const;
+
+  /**
+   * @return highest target for a motor at act_rpm, rising at most as fast as the regulator
+   * reference while within budget and falling as fast once the prediction exceeds it
+   */
+  int32_t getMaxRpm(int32_t act_rpm) const;
+
+  double getResistance(int pack) const;   // ohm
+
+ private:
+  struct Pack {
+    bool      reported;
+    uint16_t  voltage;                    // dV, last report
+    int16_t   current;                    // dA, last report
+    uint64_t  time;                       // of the last report
+    double    resistance;                 // ohm
+    double    slope;                      // A/s of the current between reports
+    double    limit;                      // A
+  };
+
+  /**
+   * @return current the pack may supply at its last report without crossing a limit
+   */
+  static double calculateLimit(const Pack& pack, const data::BatteryData& battery);
+
+  double getPredictedCurrent(const Pack& pack) const;   // A
+
+  Pack      packs_[kNumPacks];
+  uint64_t  time_;
+  int       worst_;                       // pack with the least headroom
+};
+
+}}  // namespace hyped::motor_control
+
+#endif  // PROPULSION_CURRENT_BUDGET_HPP_
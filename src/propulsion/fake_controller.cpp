@@ -22,7 +22,7 @@
 namespace hyped {
 namespace motor_control {
 
-FakeController::FakeController(Logger& log, uint8_t id, bool isFaulty)
+FakeController::FakeController(Logger& log, uint8_t id, bool isFaulty, PodModel* model)
   : log_(log),
     data_(data::Data::getInstance()),
     motor_data_(data_.getMotorData()),
@@ -32,7 +32,8 @@ FakeController::FakeController(Logger& log, uint8_t id, bool isFaulty)
     actual_velocity_(0),
     start_time_(0),
     timer_started_(false),
-    motor_temp_(60)
+    motor_temp_(60),
+    model_(model)
 {
 }
 
@@ -64,6 +65,7 @@ void FakeController::enterPreOperational()
   }
   state_ = kSwitchOnDisabled;
   actual_velocity_ = 0;
+  if (model_) model_->disable(id_);
 }
 
 void FakeController::checkState()
@@ -78,6 +80,7 @@ void FakeController::sendTargetVelocity(int32_t target_velocity)
   }
   log_.DBG2("MOTOR", "Controller %d: Updating target velocity to %d", id_, target_velocity);
   actual_velocity_ = target_velocity;
+  if (model_) model_->setTargetRpm(id_, target_velocity);
 }
 
 void FakeController::updateActualVelocity()
@@ -85,12 +88,14 @@ void FakeController::updateActualVelocity()
 
 int32_t FakeController::getVelocity()
 {
+  if (model_) return model_->getRpm(id_);
   return actual_velocity_;
 }
 
 void FakeController::quickStop()
 {
   log_.DBG1("MOTOR", "Controller %d: Sending quick stop command", id_);
+  if (model_) model_->setTargetRpm(id_, 0);
 }
 
 void FakeController::healthCheck()
@@ -118,6 +123,7 @@ ControllerState FakeController::getControllerState()
 
 uint8_t FakeController::getMotorTemp()
 {
+  if (model_) return model_->getMotorTemp(id_);
   return motor_temp_;
 }
 }}  // namespace hyped::motor_control
@@ -25,6 +25,7 @@
 #include "data/data.hpp"
 #include "utils/timer.hpp"
 #include "propulsion/controller_interface.hpp"
+#include "propulsion/pod_model.hpp"
 #include "utils/logger.hpp"
 #include "utils/io/can.hpp"
 
@@ -40,8 +41,10 @@ class FakeController : public ControllerInterface {
  public:
   /**
    * @brief  Construct a new Fake Controller object
+   * @param model - optional, when given motor id of the model is driven instead of the actual
+   *                velocity following the target instantly
    */
-  FakeController(Logger& log, uint8_t id, bool isFaulty);
+  FakeController(Logger& log, uint8_t id, bool isFaulty, PodModel* model = nullptr);
   /**
    * @brief  Registers controller to recieve and transmit CAN messages.
    *         note: empty implementation.
@@ -64,7 +67,7 @@ class FakeController : public ControllerInterface {
    */
   void checkState() override;
   /**
-   * @brief  Sets actual velocity = target velocity
+   * @brief  Sets actual velocity = target velocity, or the target of the model's motor
    * @param[in]  target_velocity in rpm (Calculated in speed calculator).
    */
   void sendTargetVelocity(int32_t target_velocity) override;
@@ -104,6 +107,7 @@ class FakeController : public ControllerInterface {
   void processErrorMessage(uint16_t error_message) override {/*EMPTY*/}
   void processSdoMessage(utils::io::can::Frame& message) override {/*EMPTY*/}
   void processNmtMessage(utils::io::can::Frame& message) override {/*EMPTY*/}
+  void processPdoMessage(utils::io::can::Frame& message) override {/*EMPTY*/}
   void requestStateTransition(utils::io::can::Frame& message,
                               ControllerState state) override {/*EMPTY*/}
   void updateMotorTemp() override {/*EMPTY*/}
@@ -126,6 +130,7 @@ class FakeController : public ControllerInterface {
   bool              timer_started_;
   uint64_t          fail_time_;
   uint8_t           motor_temp_;
+  PodModel*         model_;
 };
 
 }}  //  namespace hyped::utils
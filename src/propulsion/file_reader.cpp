@@ -22,6 +22,8 @@
  * TODO(Iain): reimplement to recieve a path to a file and then iterate through all the
  *             messages to initialise them.
  */
+#include <ctype.h>
+
 #include <string>
 #include <vector>
 
@@ -46,17 +48,30 @@ bool FileReader::readFileData(ControllerMessage* messages, int len, const char*
     while (fgets(line, static_cast<int>(sizeof(line)/sizeof(line[0])), fp) != NULL) {
       if (line[0] == '\n' || line[0] == '\0') {
       } else if (line[0] == '#') {
+      } else if (m >= len) {
+        log_.ERR("MOTOR", "More than %d messages in %s", len, filepath);
+        fclose(fp);
+        return false;
       } else if (line[0] == '>') {
-        for (int i = 1; i < static_cast<int>(strlen(line)) -1; i++) {
-          messages[m].logger_output[i-1] = line[i];
-        }
+        // drop the marker and trailing whitespace, the generated tables do the same
+        int end = strlen(line);
+        while (end > 1 && isspace(line[end - 1])) end--;
+        memcpy(messages[m].logger_output, line + 1, end - 1);
+        messages[m].logger_output[end - 1] = '\0';
       } else {
         std::string lineData[8];
         splitData(line, lineData);
         addData(lineData, messages[m].message_data);
+        messages[m].len = 8;
         m++;
       }
     }
+    // the rest of the array would keep whatever it held before
+    if (m < len) {
+      log_.ERR("MOTOR", "Only %d of %d messages in %s", m, len, filepath);
+      fclose(fp);
+      return false;
+    }
   }
   fclose(fp);
   return true;
@@ -46,6 +46,7 @@ class FileReader {
    *
    * @param message
    * @param len - length of messages array
+   * @return true iff the file holds exactly len messages
    */
   static bool readFileData(ControllerMessage messages[], int len, const char* filepath);
 
@@ -18,6 +18,8 @@
 
 #include "propulsion/main.hpp"
 
+#include "utils/config.hpp"
+
 namespace hyped {
 
 namespace motor_control {
@@ -50,6 +52,7 @@ void Main::run()
   utils::System &sys      = utils::System::getSystem();
   data::Data &data        = data::Data::getInstance();
   data::Motors motor_data = data.getMotorData();
+  uint64_t control_period = sys.config->motor_control.control_period;
 
   // Initialise states
   current_state_  = data.getStateMachineData().current_state;
@@ -60,24 +63,29 @@ void Main::run()
   data.setMotorData(motor_data);
   log_.INFO("Motor", "Initialisation complete");
 
+  uint32_t update    = 0;
+  uint64_t next_tick = utils::Timer::getTimeMicros();
   while (is_running_ && sys.running_) {
     // Get the current state of the system from the state machine's data
     motor_data                  = data.getMotorData();
     current_state_              = data.getStateMachineData().current_state;
     bool encountered_transition = handleTransition();
+    bool ticking                = false;
 
     switch (current_state_) {
       case State::kIdle:
         break;
       case State::kCalibrating:
+        if (!state_processor_->isInitialized()) {
+          state_processor_->initMotors();
+          if (state_processor_->isCriticalFailure()) { handleCriticalFailure(data, motor_data); }
+        }
+        // report ready straight away, nothing would wake the loop to do it later
         if (state_processor_->isInitialized()) {
           if (motor_data.module_status != ModuleStatus::kReady) {
             motor_data.module_status = ModuleStatus::kReady;
             data.setMotorData(motor_data);
           }
-        } else {
-          state_processor_->initMotors();
-          if (state_processor_->isCriticalFailure()) { handleCriticalFailure(data, motor_data); }
         }
         break;
       case State::kReady:
@@ -85,16 +93,31 @@ void Main::run()
         break;
       case State::kAccelerating:
         state_processor_->accelerate();
+        ticking = true;
         break;
       case State::kCruising:
       case State::kNominalBraking:
       case State::kEmergencyBraking:
         state_processor_->quickStopAll();
+        ticking = true;
         break;
       default:
         handleCriticalFailure(data, motor_data);
         break;
     }
+
+    // Sleep until the state machine moves on, or the next control tick while the motors are
+    // driven. The wait is bounded so that the loop notices the system shutting down.
+    uint64_t now     = utils::Timer::getTimeMicros();
+    uint64_t timeout = kIdleTimeout;
+    if (ticking) {
+      if (next_tick <= now) next_tick += control_period;
+      if (next_tick <= now) next_tick = now + control_period;   // fell behind, do not burst
+      timeout = next_tick - now;
+    } else {
+      next_tick = now;
+    }
+    if (is_running_) update = data.waitForStateMachineData(update, timeout);
   }
 
   log_.INFO("Motor", "Thread shutting down");
@@ -53,6 +53,9 @@ class Main : public Thread {
   void run() override;
 
  private:
+  // longest the loop sleeps in states without a control tick, it wakes on every transition
+  static constexpr uint64_t kIdleTimeout = 100000;    // microseconds
+
   bool is_running_;
   Logger &log_;
   StateProcessor *state_processor_;
@@ -0,0 +1,233 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Physics model of the motors and the pod
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "propulsion/pod_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hyped {
+namespace motor_control {
+
+constexpr int      PodModel::kNumMotors;
+constexpr uint64_t PodModel::kStep;
+constexpr double   PodModel::kMass;
+constexpr double   PodModel::kRollingResistance;
+constexpr double   PodModel::kDragArea;
+constexpr double   PodModel::kAirDensity;
+constexpr double   PodModel::kBrakeDeceleration;
+constexpr double   PodModel::kRotorInertia;
+constexpr double   PodModel::kRotorRadius;
+constexpr double   PodModel::kStallTorque;
+constexpr double   PodModel::kRpmPerVolt;
+constexpr double   PodModel::kSpeedGain;
+constexpr double   PodModel::kTorqueConstant;
+constexpr double   PodModel::kWindingResistance;
+constexpr double   PodModel::kEfficiency;
+constexpr double   PodModel::kPeakThrust;
+constexpr double   PodModel::kPeakSlip;
+constexpr double   PodModel::kOpenCircuitVoltage;
+constexpr double   PodModel::kInternalResistance;
+constexpr double   PodModel::kAmbient;
+constexpr double   PodModel::kHeatCapacity;
+constexpr double   PodModel::kThermalResistance;
+
+namespace {
+
+constexpr double kGravity       = 9.81;
+constexpr double kRpmToRadians  = 2 * M_PI / 60;
+
+}   // namespace
+
+PodModel::PodModel(utils::Clock& clock)
+    : clock_(clock),
+      data_(data::Data::getInstance()),
+      time_(clock.getTimeMicros()),
+      velocity_(0),
+      distance_(0),
+      acceleration_(0),
+      current_(0),
+      voltage_(kOpenCircuitVoltage),
+      brakes_(false),
+      publish_batteries_(false)
+{
+  for (int i = 0; i < kNumMotors; i++) {
+    target_rpm_[i]  = 0;
+    enabled_[i]     = false;
+    rpm_[i]         = 0;
+    temperature_[i] = kAmbient;
+  }
+}
+
+void PodModel::update()
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+}
+
+void PodModel::catchUp()
+{
+  uint64_t now = clock_.getTimeMicros();
+  while (time_ + kStep <= now) {
+    step(kStep / 1e6);
+    time_ += kStep;
+  }
+}
+
+double PodModel::getThrust(double slip)
+{
+  // like the torque of an induction machine, linear at small slip and falling off beyond the peak
+  return 2 * kPeakThrust * slip * kPeakSlip / (slip * slip + kPeakSlip * kPeakSlip);
+}
+
+void PodModel::step(double dt)
+{
+  double thrust        = 0;
+  double battery_power = 0;
+  for (int i = 0; i < kNumMotors; i++) {
+    double omega  = rpm_[i] * kRpmToRadians;
+    double torque = 0;
+    if (enabled_[i]) {
+      // the speed loop of the controller, bounded by what the motor gives at this voltage
+      double no_load    = kRpmPerVolt * voltage_;
+      double max_torque = kStallTorque * std::max(0.0, 1 - rpm_[i] / no_load);
+      double demand     = kSpeedGain * (target_rpm_[i] - rpm_[i]);
+      torque = std::max(-kStallTorque, std::min(max_torque, demand));
+    }
+
+    double coupling = getThrust(omega * kRotorRadius - velocity_);
+    omega   += (torque - coupling * kRotorRadius) / kRotorInertia * dt;
+    rpm_[i]  = std::max(0.0, omega / kRpmToRadians);
+    thrust  += coupling;
+
+    // driving draws more than the shaft power, regenerating returns less
+    double power   = torque * omega;
+    battery_power += power > 0 ? power / kEfficiency : power * kEfficiency;
+
+    double winding_current = std::fabs(torque) / kTorqueConstant;
+    double heat = winding_current * winding_current * kWindingResistance;
+    temperature_[i] += (heat - (temperature_[i] - kAmbient) / kThermalResistance)
+                     / kHeatCapacity * dt;
+  }
+
+  double resistance = kDragArea * kAirDensity * velocity_ * velocity_ / 2;
+  if (velocity_ > 0) resistance += kRollingResistance * kMass * kGravity;
+  if (brakes_ && velocity_ > 0) resistance += kBrakeDeceleration * kMass;
+
+  acceleration_ = (thrust - resistance) / kMass;
+  velocity_    += acceleration_ * dt;
+  if (velocity_ < 0) {
+    // brakes and friction hold the pod, they do not push it back
+    velocity_     = 0;
+    acceleration_ = 0;
+  }
+  distance_ += velocity_ * dt;
+
+  current_ = battery_power / voltage_;
+  voltage_ = kOpenCircuitVoltage - current_ * kInternalResistance;
+  if (publish_batteries_) publishBatteries();
+}
+
+void PodModel::publishBatteries()
+{
+  data::Batteries batteries = data_.getBatteriesData();
+  for (data::BatteryData& battery : batteries.high_power_batteries) {
+    // packs in parallel share the current
+    battery.voltage = static_cast<uint16_t>(voltage_ * 10);
+    battery.current = static_cast<int16_t>(current_ * 10 / data::Batteries::kNumHPBatteries);
+  }
+  data_.setBatteriesData(batteries);
+}
+
+void PodModel::setTargetRpm(int motor, int32_t rpm)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  target_rpm_[motor] = rpm;
+  enabled_[motor]    = true;
+}
+
+void PodModel::disable(int motor)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  enabled_[motor] = false;
+}
+
+void PodModel::setBrakes(bool applied)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  brakes_ = applied;
+}
+
+void PodModel::setPublishBatteries(bool publish)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  publish_batteries_ = publish;
+}
+
+int32_t PodModel::getRpm(int motor)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return std::lround(rpm_[motor]);
+}
+
+uint8_t PodModel::getMotorTemp(int motor)
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return static_cast<uint8_t>(std::min(255.0, std::max(0.0, temperature_[motor])));
+}
+
+double PodModel::getVelocity()
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return velocity_;
+}
+
+double PodModel::getDistance()
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return distance_;
+}
+
+double PodModel::getAcceleration()
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return acceleration_;
+}
+
+double PodModel::getBatteryCurrent()
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return current_;
+}
+
+double PodModel::getBatteryVoltage()
+{
+  utils::concurrent::ScopedLock L(&lock_);
+  catchUp();
+  return voltage_;
+}
+
+}}  // namespace hyped::motor_control
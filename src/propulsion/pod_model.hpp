@@ -0,0 +1,138 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Physics model of the motors and the pod for FakeController. Every motor controller runs a
+ * speed loop whose torque is bounded by the torque-speed curve of the motor at the present
+ * battery voltage. Rotors of finite inertia push the pod through a slip coupling whose thrust
+ * peaks at kPeakSlip. The pod is slowed by rolling resistance and aerodynamic drag, and by the
+ * friction brakes once they are applied. Battery current makes the pack voltage sag and heats
+ * the motor windings.
+ *
+ * The model advances in fixed steps of kStep up to the time of its clock, so on a ManualClock
+ * a run takes only the time needed to compute it.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef PROPULSION_POD_MODEL_HPP_
+#define PROPULSION_POD_MODEL_HPP_
+
+#include <cstdint>
+
+#include "data/data.hpp"
+#include "utils/clock.hpp"
+#include "utils/concurrent/lock.hpp"
+#include "utils/utils.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+class PodModel {
+ public:
+  static constexpr int      kNumMotors  = data::Motors::kNumMotors;
+  static constexpr uint64_t kStep       = 1000;       // microseconds of one integration step
+
+  // pod
+  static constexpr double kMass               = 250;      // kg
+  static constexpr double kRollingResistance  = 0.005;
+  static constexpr double kDragArea           = 0.3;      // drag coefficient times area, m^2
+  static constexpr double kAirDensity         = 1.2;      // kg/m^3
+  static constexpr double kBrakeDeceleration  = 12;       // m/s^2 with the brakes applied
+
+  // motor and controller
+  static constexpr double kRotorInertia       = 0.05;     // kg m^2
+  static constexpr double kRotorRadius        = 0.1;      // m
+  static constexpr double kStallTorque        = 60;       // Nm
+  static constexpr double kRpmPerVolt         = 60;       // no load rpm at 1 V
+  static constexpr double kSpeedGain          = 2;        // Nm per rpm of speed error
+  static constexpr double kTorqueConstant     = 0.5;      // Nm/A
+  static constexpr double kWindingResistance  = 0.05;     // ohm
+  static constexpr double kEfficiency         = 0.85;     // of inverter and motor
+
+  // slip coupling
+  static constexpr double kPeakThrust         = 250;      // N per motor
+  static constexpr double kPeakSlip           = 30;       // m/s of rotor surface over pod
+
+  // battery
+  static constexpr double kOpenCircuitVoltage = 130;      // V
+  static constexpr double kInternalResistance = 0.02;     // ohm
+
+  // thermal
+  static constexpr double kAmbient            = 25;       // C
+  static constexpr double kHeatCapacity       = 2000;     // J/K of one motor
+  static constexpr double kThermalResistance  = 0.5;      // K/W from winding to ambient
+
+  /**
+   * @param clock - time base the model follows, e.g. a ManualClock in tests
+   */
+  explicit PodModel(utils::Clock& clock = utils::Clock::getSystemClock());
+
+  /**
+   * @brief Catch up with the clock. All getters and setters below do this first.
+   */
+  void update();
+
+  void setTargetRpm(int motor, int32_t rpm);
+
+  /**
+   * @brief Stop driving the motor, its rotor spins down against the coupling
+   */
+  void disable(int motor);
+
+  void setBrakes(bool applied);
+
+  /**
+   * @brief Write the battery current and voltage of every step to the high power batteries in
+   * Data, so that consumers of battery data see the load of the motors
+   */
+  void setPublishBatteries(bool publish);
+
+  int32_t getRpm(int motor);
+  uint8_t getMotorTemp(int motor);
+  double getVelocity();                 // m/s
+  double getDistance();                 // m
+  double getAcceleration();             // m/s^2
+  double getBatteryCurrent();           // A
+  double getBatteryVoltage();           // V
+
+ private:
+  void catchUp();                       // lock_ must be held
+  void step(double dt);                 // lock_ must be held
+  void publishBatteries();              // lock_ must be held
+
+  /**
+   * @return thrust of one coupling at slip m/s of rotor surface over the pod
+   */
+  static double getThrust(double slip);
+
+  utils::Clock&     clock_;
+  data::Data&       data_;
+  uint64_t          time_;
+  double            target_rpm_[kNumMotors];
+  bool              enabled_[kNumMotors];
+  double            rpm_[kNumMotors];
+  double            temperature_[kNumMotors];
+  double            velocity_;
+  double            distance_;
+  double            acceleration_;
+  double            current_;
+  double            voltage_;
+  bool              brakes_;
+  bool              publish_batteries_;
+  utils::concurrent::Lock lock_;
+  NO_COPY_ASSIGN(PodModel);
+};
+
+}}  // namespace hyped::motor_control
+
+#endif  // PROPULSION_POD_MODEL_HPP_
@@ -18,12 +18,46 @@
 
 #include "propulsion/state_processor.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "utils/concurrent/thread.hpp"
+
 namespace hyped
 {
 
 namespace motor_control
 {
 
+namespace
+{
+
+/**
+ * @brief Runs one phase, e.g. configure(), of one controller on its own thread
+ */
+class ControllerPhase : public utils::concurrent::Thread
+{
+  public:
+    ControllerPhase(Logger& log, ControllerInterface* controller,
+                    StateProcessor::Phase phase)
+      : Thread(log),
+        controller_(controller),
+        phase_(phase)
+    {}
+
+    void run() override
+    {
+      (controller_->*phase_)();
+    }
+
+  private:
+    ControllerInterface* controller_;
+    StateProcessor::Phase phase_;
+};
+
+}  // namespace
+
 StateProcessor::StateProcessor(int motorAmount, Logger &log)
   : log_(log),
   sys_(System::getSystem()),
@@ -40,8 +74,6 @@ StateProcessor::StateProcessor(int motorAmount, Logger &log)
 
   useFakeController = sys_.fake_motors;
 
-  navigationData = data_.getNavigationData();
-
   controllers = new ControllerInterface*[motorAmount];
 
   if (useFakeController) {  // Use the test controllers implementation
@@ -100,76 +132,129 @@ void StateProcessor::registerControllers()
   }
 }
 
+bool StateProcessor::runOnAllControllers(Phase phase)
+{
+  std::vector<std::unique_ptr<ControllerPhase>> threads;
+  for (int i = 0; i < motorAmount; i++) {
+    threads.emplace_back(new ControllerPhase(log_, controllers[i], phase));
+    threads.back()->start();
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  bool success = true;
+  for (int i = 0; i < motorAmount; i++) {
+    if (controllers[i]->getFailure()) {
+      log_.ERR("Motor", "Controller %d failed", i);
+      success = false;
+    }
+  }
+  return success;
+}
+
 void StateProcessor::configureControllers()
 {
-  for (int i = 0;i < motorAmount; i++) {
-    controllers[i]->configure();
+  if (!runOnAllControllers(&ControllerInterface::configure)) {
+    log_.ERR("Motor", "Could not configure all controllers");
   }
 }
 
 void StateProcessor::prepareMotors()
 {
-  for (int i = 0;i < motorAmount; i++) {
-    controllers[i]->enterOperational();
+  if (!runOnAllControllers(&ControllerInterface::enterOperational)) {
+    log_.ERR("Motor", "Could not enable all controllers");
   }
 
-  // Setup acceleration timer
+  // Setup acceleration timer, the first control period starts now
   accelerationTimer.start();
-  accelerationTimestamp = 0;
+  accelerationTimestamp = accelerationTimer.getTimeMicros();
+  regulator.reset(0);
+  budget = CurrentBudget();
 }
 
 void StateProcessor::enterPreOperational()
 {
-  for (int i = 0;i < motorAmount; i++) {
-    controllers[i]->enterPreOperational();
+  if (!runOnAllControllers(&ControllerInterface::enterPreOperational)) {
+    log_.ERR("Motor", "Could not shut down all controllers");
   }
 }
 
 void StateProcessor::accelerate()
 {
   if (initialized) {
-    motor_data_ = data_.getMotorData();
-    for (int i = 0; i < motorAmount; i++) {
-      controllers[i]->updateActualVelocity();
-      motor_data_.rpms[i] = controllers[i]->getVelocity();
+    // the regulator runs once per period, periods missed by a slow loop are caught up on
+    uint64_t now = accelerationTimer.getTimeMicros();
+    if (now < accelerationTimestamp) return;
+
+    log_.DBG3("Motor", "Accelerate");
+    const ControlSnapshot snapshot = takeSnapshot();
+
+    // the regulator keeps clear of the current the batteries are expected to draw shortly
+    int32_t rpm = snapshot.average_rpm;
+    regulator.setCurrentLimit(snapshot.current_limit);
+    for (int i = 0; i < kMaxCatchUp && accelerationTimestamp <= now; i++) {
+      rpm = regulator.calculateRPM(snapshot.velocity, snapshot.average_rpm,
+                                   snapshot.predicted_current, snapshot.max_temp);
+      accelerationTimestamp += RPM_Regulator::kPeriod;
+    }
+    if (accelerationTimestamp <= now) {
+      log_.DBG("Motor", "Skipping %d control periods",
+               static_cast<int>((now - accelerationTimestamp) / RPM_Regulator::kPeriod + 1));
+      accelerationTimestamp = now + RPM_Regulator::kPeriod;
     }
-    data_.setMotorData(motor_data_);
-
-    if (accelerationTimer.getTimeMicros() - accelerationTimestamp > 5000) {
-      log_.DBG3("Motor", "Accelerate");
-      accelerationTimestamp = accelerationTimer.getTimeMicros();
-      velocity = navigationData.velocity;
-
-      int32_t act_rpm = calcAverageRPM(controllers);
-      int32_t act_current = calcMaxCurrent();
-      int32_t act_temp = calcMaxTemp(controllers);
-
-      int32_t rpm = regulator.calculateRPM(velocity, act_rpm, act_current, act_temp);
 
-      log_.INFO("MOTOR", "Sending %d rpm as target", rpm);
+    log_.INFO("MOTOR", "Sending %d rpm as target", rpm);
 
-      for (int i = 0;i < motorAmount; i++) {
-        controllers[i]->sendTargetVelocity(rpm);
-      }
+    // a motor ahead of the others must not take the packs beyond their budget
+    for (int i = 0;i < motorAmount; i++) {
+      controllers[i]->sendTargetVelocity(std::min(rpm, budget.getMaxRpm(snapshot.rpms[i])));
     }
   } else {
     log_.INFO("Motor", "State Processor not initialized");
   }
 }
 
+ControlSnapshot StateProcessor::takeSnapshot()
+{
+  // one exchange per controller for velocity and temperature, none while they arrive by PDO
+  for (int i = 0; i < motorAmount; i++) {
+    controllers[i]->updateActualValues();
+  }
+
+  ControlSnapshot snapshot;
+  snapshot.timestamp = accelerationTimer.getTimeMicros();
+  snapshot.velocity  = data_.getNavigationData().velocity;
+
+  motor_data_ = data_.getMotorData();
+  for (int i = 0; i < motorAmount; i++) {
+    snapshot.rpms.push_back(controllers[i]->getVelocity());
+    if (i < Motors::kNumMotors) motor_data_.rpms[i] = snapshot.rpms[i];
+  }
+  data_.setMotorData(motor_data_);
+  snapshot.average_rpm = calcAverageRPM(controllers);
+  snapshot.max_temp    = calcMaxTemp(controllers);
+
+  Batteries batteries = data_.getBatteriesData();
+  budget.update(batteries, snapshot.timestamp);
+  snapshot.max_current       = calcMaxCurrent(batteries);
+  snapshot.predicted_current = budget.getPredictedCurrent();
+  snapshot.current_limit     = budget.getCurrentLimit();
+  return snapshot;
+}
+
 int32_t StateProcessor::calcAverageRPM(ControllerInterface** controllers)
 {
+  // takeSnapshot() updated the velocities just before
   int32_t total = 0;
   for (int i = 0; i < motorAmount; i++) {
-    controllers[i]->updateActualVelocity();
     total += controllers[i]->getVelocity();
   }
   return std::round(total/motorAmount);
 }
 
-int16_t StateProcessor::calcMaxCurrent()
+int16_t StateProcessor::calcMaxCurrent(const Batteries& hp_packs)
 {
-  Batteries hp_packs = data_.getBatteriesData();
   int16_t max_current = 0;
   for (int i = 0; i < hp_packs.kNumHPBatteries; i++) {
     int16_t current = hp_packs.high_power_batteries[i].current;
@@ -184,7 +269,6 @@ int32_t StateProcessor::calcMaxTemp(ControllerInterface** controllers)
 {
   int32_t max_temp = 0;
   for (int i = 0; i < motorAmount; i++) {
-    controllers[i]->updateMotorTemp();
     int32_t temp = controllers[i]->getMotorTemp();
     if (max_temp < temp) {
       max_temp = temp;
@@ -19,6 +19,8 @@
 #ifndef PROPULSION_STATE_PROCESSOR_HPP_
 #define PROPULSION_STATE_PROCESSOR_HPP_
 
+#include <vector>
+
 #include "utils/logger.hpp"
 #include "utils/system.hpp"
 #include "utils/timer.hpp"
@@ -28,6 +30,7 @@
 #include "propulsion/controller.hpp"
 #include "propulsion/fake_controller.hpp"
 #include "propulsion/RPM_regulator.hpp"
+#include "propulsion/current_budget.hpp"
 #include "data/data.hpp"
 
 namespace hyped
@@ -44,9 +47,27 @@ using data::Navigation;
 using data::Data;
 using data::Motors;
 
+/**
+ * @brief Inputs of one control cycle. They are gathered once at the start of the cycle and
+ * everything in the cycle reads this copy instead of asking the controllers again.
+ */
+struct ControlSnapshot {
+  uint64_t  timestamp;          // microseconds of accelerationTimer when gathered
+  float     velocity;           // m/s from navigation
+  std::vector<int32_t> rpms;    // of every motor
+  int32_t   average_rpm;
+  int32_t   max_current;        // dA of the high power pack drawing the most
+  int32_t   predicted_current;  // dA of the most loaded pack at the next BMS report
+  int32_t   current_limit;      // dA that pack may supply
+  int32_t   max_temp;           // C of the hottest motor
+};
+
 class StateProcessor : public StateProcessorInterface
 {
   public:
+    // one step of bringing a controller up or down, e.g. &ControllerInterface::configure
+    typedef void (ControllerInterface::*Phase)();
+
     /**
      * @brief {Initializes the state processors with the amount of motors and the logger}
      * */
@@ -118,6 +139,12 @@ class StateProcessor : public StateProcessorInterface
      */
     void prepareMotors() override;
 
+    /**
+     * @brief Refresh the actual values of all controllers, publish the rpms and gather the
+     * inputs of this control cycle
+     */
+    ControlSnapshot takeSnapshot();
+
     /**
      * @brief Calculate the Average rpm of all motors
      *
@@ -127,21 +154,32 @@ class StateProcessor : public StateProcessorInterface
     int32_t calcAverageRPM(ControllerInterface** controllers);
 
     /**
-     * @brief calculate the max Current drawn out of all the motors
+     * @brief calculate the max Current drawn out of all the high power packs
      *
-     * @param controllers
-     * @return int32_t
+     * @param hp_packs
+     * @return int16_t
      */
-    int16_t calcMaxCurrent();
+    int16_t calcMaxCurrent(const Batteries& hp_packs);
 
     /**
-     * @brief Calculate the max temperature out of all the motors
+     * @brief Calculate the max temperature out of all the motors, as last updated
      *
      * @param controllers
      * @return int32_t
      */
     int32_t calcMaxTemp(ControllerInterface** controllers);
 
+    /**
+     * @brief Runs phase on every controller at the same time, each on its own thread, and
+     * waits for all of them. The time taken is that of the slowest controller.
+     *
+     * @return false iff any controller reports a failure afterwards
+     */
+    bool runOnAllControllers(Phase phase);
+
+    // control periods accelerate() runs at most to catch up with the clock
+    static constexpr int kMaxCatchUp = 4;
+
     bool useFakeController;
     Logger &log_;
     System &sys_;
@@ -154,9 +192,8 @@ class StateProcessor : public StateProcessorInterface
     float speed;
     ControllerInterface **controllers;
     RPM_Regulator regulator;
-    float velocity;
-    Navigation navigationData;
-    uint64_t accelerationTimestamp;
+    CurrentBudget budget;
+    uint64_t accelerationTimestamp;   // start of the next control period
     Timer accelerationTimer;
 };
 
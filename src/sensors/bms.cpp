@@ -20,6 +20,8 @@
 
 #include "sensors/bms.hpp"
 
+#include <vector>
+
 #include "utils/logger.hpp"
 #include "utils/timer.hpp"
 
@@ -35,7 +37,7 @@ BMS::BMS(uint8_t id, Logger& log)
       id_(id),
       id_base_(bms::kIdBase + (bms::kIdIncrement * id_)),
       last_update_time_(0),
-      can_(Can::getInstance()),
+      can_(Can::getBmsBus()),
       running_(false)
 {
   ASSERT(id < data::Batteries::kNumLPBatteries);
@@ -102,6 +104,12 @@ bool BMS::hasId(uint32_t id, bool extended)
   return false;
 }
 
+void BMS::getIdRanges(std::vector<utils::io::can::IdRange>* ranges)
+{
+  ranges->push_back({id_base_, id_base_ + bms::kIdSize - 1, true});   // LP BMS CAN messages
+  ranges->push_back({0x28, 0x28, true});                              // LP current CAN message
+}
+
 void BMS::processNewData(utils::io::can::Frame& message)
 {
   log_.DBG1("BMS", "module %u: received CAN message with id %d", id_, message.id);
@@ -140,7 +148,7 @@ void BMS::processNewData(utils::io::can::Frame& message)
           id_, message.id, offset);
   }
 
-  last_update_time_ = utils::Timer::getTimeMicros();
+  last_update_time_ = message.timestamp;
 }
 
 bool BMS::isOnline()
@@ -184,28 +192,46 @@ void BMS::getData(BatteryData* battery)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // BMSHP
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-std::vector<uint16_t> BMSHP::existing_ids_;   // NOLINT [build/include_what_you_use]
+std::vector<std::pair<const Can*, uint16_t>> BMSHP::existing_ids_;  // NOLINT
 
 BMSHP::BMSHP(uint16_t id, Logger& log)
+    : BMSHP(id, log, Can::getBmsBus())
+{ /* EMPTY */ }
+
+BMSHP::BMSHP(uint16_t id, Logger& log, Can& can)
     : log_(log),
       can_id_(id*2 + bms::kHPBase),
       thermistor_id_(id + bms::kThermistorBase),
       cell_id_(id + bms::kCellBase),
       local_data_ {},
-      last_update_time_(0)
+      last_update_time_(0),
+      can_(can),
+      registered_(false)
 {
   // verify this BMSHP unit has not been instantiated
-  for (uint16_t i : existing_ids_) {
-    if (id == i) {
+  for (auto& existing : existing_ids_) {
+    if (existing.first == &can_ && existing.second == id) {
       log_.ERR("BMSHP", "BMSHP %d already exists, duplicate unit instantiation", id);
       return;
     }
   }
-  existing_ids_.push_back(id);
+  existing_ids_.push_back({&can_, id});
+  registered_ = true;
 
   // tell CAN about yourself
-  Can::getInstance().registerProcessor(this);
-  Can::getInstance().start();
+  can_.registerProcessor(this);
+  can_.start();
+}
+
+BMSHP::~BMSHP()
+{
+  if (!registered_) return;
+  for (auto it = existing_ids_.begin(); it != existing_ids_.end(); ++it) {
+    if (it->first == &can_ && it->second == (can_id_ - bms::kHPBase) / 2) {
+      existing_ids_.erase(it);
+      return;
+    }
+  }
 }
 
 bool BMSHP::isOnline()
@@ -245,6 +271,21 @@ bool BMSHP::hasId(uint32_t id, bool extended)
   return false;
 }
 
+void BMSHP::getIdRanges(std::vector<utils::io::can::IdRange>* ranges)
+{
+  // hasId() does not distinguish standard and extended ids, the ids are declared with the
+  // format they are sent in, i.e. ids above 0x7FF are extended
+  constexpr uint32_t kStandardIds[] = {0x7E4, 0x6D0, 0x7EC, 0x70, 0x80, 0x6B4, 0x6B5};
+  constexpr uint32_t kExtendedIds[] = {0x1838F380, 0x18EEFF80, 0x1838F381, 0x18EEFF81};
+
+  ranges->push_back({can_id_, static_cast<uint16_t>(can_id_ + 1), false});   // HPBMS
+  ranges->push_back({cell_id_, cell_id_, false});                             // broadcast
+  ranges->push_back({static_cast<uint32_t>(thermistor_id_),
+                     static_cast<uint32_t>(thermistor_id_), true});          // thermistor module
+  for (uint32_t id : kStandardIds) ranges->push_back({id, id, false});
+  for (uint32_t id : kExtendedIds) ranges->push_back({id, id, true});
+}
+
 void BMSHP::processNewData(utils::io::can::Frame& message)
 {
   // thermistor expansion module
@@ -279,7 +320,7 @@ void BMSHP::processNewData(utils::io::can::Frame& message)
       local_data_.imd_fault = false;
     }
   }
-  last_update_time_ = utils::Timer::getTimeMicros();
+  last_update_time_ = message.timestamp;
 
   // individual cell voltages, configured at 100ms refresh rate
   if (message.id == cell_id_) {
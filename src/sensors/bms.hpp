@@ -26,6 +26,7 @@
 #define SENSORS_BMS_HPP_
 
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "sensors/interface.hpp"
@@ -112,6 +113,7 @@ class BMS : public Thread, public CanProccesor, public BMSInterface {
 
   // From CanProcessor interface
   bool hasId(uint32_t id, bool extended) override;
+  void getIdRanges(std::vector<utils::io::can::IdRange>* ranges) override;
 
  private:
   /**
@@ -154,12 +156,21 @@ class BMSHP : public CanProccesor, public BMSInterface {
    */
   BMSHP(uint16_t id, Logger& log = utils::System::getLogger());
 
+  /**
+   * @brief Construct a new BMSHP object listening on the given bus instead of the configured
+   * BMS bus
+   */
+  BMSHP(uint16_t id, Logger& log, Can& can);
+
+  ~BMSHP();
+
   // from BMSInterface
   bool isOnline() override;
   void getData(BatteryData* battery) override;
 
   // from CanProcessor
   bool hasId(uint32_t id, bool extended) override;
+  void getIdRanges(std::vector<utils::io::can::IdRange>* ranges) override;
 
  private:
   void processNewData(utils::io::can::Frame& message) override;
@@ -171,8 +182,10 @@ class BMSHP : public CanProccesor, public BMSInterface {
   uint16_t        cell_id_;           // broadcast message ID
   BatteryData     local_data_;        // stores values from CAN
   uint64_t        last_update_time_;  // stores arrival time of CAN message
-  // for making sure only one object per BMS unit exist
-  static std::vector<uint16_t> existing_ids_;
+  Can&            can_;
+  bool            registered_;
+  // for making sure only one object per BMS unit and bus exist
+  static std::vector<std::pair<const Can*, uint16_t>> existing_ids_;
   NO_COPY_ASSIGN(BMSHP);
 };
 
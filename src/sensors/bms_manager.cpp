@@ -170,34 +170,35 @@ bool BmsManager::batteriesInRange()
   // check HP
   for (int i = 0; i < data::Batteries::kNumHPBatteries; i++) {
     auto &battery = batteries_.high_power_batteries[i];      // reference batteries individually
-    if (battery.voltage < 1000 || battery.voltage > 1296) {  // voltage in 100V to 129.6V
+    if (battery.voltage < data::Batteries::kMinHPVoltage
+        || battery.voltage > data::Batteries::kMaxHPVoltage) {
       if (batteries_.module_status != previous_status_)
         log_.ERR("BMS-MANAGER", "BMS HP %d voltage out of range: %d", i, battery.voltage);
       return false;
     }
 
-    if (battery.current < 0 || battery.current > 3500) {  // current in 0A to 350A
+    if (battery.current < 0 || battery.current > data::Batteries::kMaxHPCurrent) {
       if (batteries_.module_status != previous_status_)
         log_.ERR("BMS-MANAGER", "BMS HP %d current out of range: %d", i, battery.current);
       return false;
     }
 
-    if (battery.average_temperature < 10
-        || battery.average_temperature > 65) {  // temperature in 10C to 65C
+    if (battery.average_temperature < data::Batteries::kMinHPTemperature
+        || battery.average_temperature > data::Batteries::kMaxHPTemperature) {
       if (batteries_.module_status != previous_status_)
         log_.ERR("BMS-MANAGER", "BMS HP %d temperature out of range: %d", i,
                  battery.average_temperature);
       return false;
     }
 
-    if (battery.low_temperature < 10) {
+    if (battery.low_temperature < data::Batteries::kMinHPTemperature) {
       if (batteries_.module_status != previous_status_)
         log_.ERR("BMS-MANAGER", "BMS HP %d temperature out of range: %d", i,
                  battery.low_temperature);
       return false;
     }
 
-    if (battery.high_temperature > 65) {
+    if (battery.high_temperature > data::Batteries::kMaxHPTemperature) {
       if (batteries_.module_status != previous_status_)
         log_.ERR("BMS-MANAGER", "BMS HP %d temperature out of range: %d", i,
                  battery.high_temperature);
@@ -47,6 +47,7 @@ FakeImuFromFile::FakeImuFromFile(utils::Logger& log,
                 bool is_fail_dec,
                 float noise)
     : log_(log),
+      generator_(rand()),
       acc_noise_(1),
       acc_file_path_(acc_file_path),
       dec_file_path_(dec_file_path),
@@ -286,11 +287,10 @@ void FakeImuFromFile::getData(ImuData* imu)
 NavigationVector FakeImuFromFile::addNoiseToData(NavigationVector value, float noise)
 {
   NavigationVector temp;
-  static std::default_random_engine generator;
 
   for (int i = 0; i < 3; i++) {
     std::normal_distribution<nav_t> distribution(value[i], noise);
-    temp[i] = distribution(generator);
+    temp[i] = distribution(generator_);
   }
   return temp;
 }
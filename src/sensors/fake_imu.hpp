@@ -20,6 +20,7 @@
 #ifndef SENSORS_FAKE_IMU_HPP_
 #define SENSORS_FAKE_IMU_HPP_
 
+#include <random>
 #include <string>
 #include <vector>
 
@@ -89,7 +90,7 @@ class FakeImuFromFile : public ImuInterface {
    *
    * @return    Returns random data point value
    */
-  static NavigationVector addNoiseToData(NavigationVector value, float noise);
+  NavigationVector addNoiseToData(NavigationVector value, float noise);
 
  private:
   utils::Logger&       log_;
@@ -135,6 +136,8 @@ class FakeImuFromFile : public ImuInterface {
    */
   bool accCheckTime();
 
+  // seeded from rand(), so a run repeats after the same srand()
+  std::default_random_engine generator_;
   NavigationVector acc_noise_;
   NavigationVector prev_acc_;
   NavigationVector acc_fail_;
@@ -73,6 +73,8 @@ void ImuManager::run()
     }
     sensors_imu_.timestamp = utils::Timer::getTimeMicros();
     data_.setSensorsImuData(sensors_imu_);
+    // reads as fast as the IMUs allow, but lets a simulation move on
+    Thread::yield();
   }
 }
 }}  // namespace hyped::sensors
@@ -24,6 +24,10 @@
 namespace hyped {
 namespace state_machine {
 
+constexpr uint32_t Main::kTransitionChannels;
+constexpr uint64_t Main::kUpdateTimeout;
+constexpr uint64_t Main::kStatsPeriod;
+
 Main::Main(uint8_t id, Logger &log) : Thread(id, log)
 {
   current_state_ = Idle::getInstance();  // set current state to point to Idle
@@ -36,24 +40,65 @@ void Main::run()
 
   current_state_->enter(log_);
 
+  data::StateMachineStats stats;
+  uint64_t published = utils::Timer::getTimeMicros();
   State *new_state;
   while (sys.running_) {
+    // counted before the transition reads the data, so an update during the check is not missed
+    uint32_t updates = data.getUpdates(kTransitionChannels);
+
     // checkTransition returns a new state or nullptr
-    if ((new_state = current_state_->checkTransition(log_))) {
+    uint64_t start = utils::Timer::getTimeMicros();
+    new_state      = current_state_->checkTransition(log_);
+    uint64_t now   = utils::Timer::getTimeMicros();
+    stats.tick_time.add(now - start);
+
+    if (new_state) {
+      uint64_t trigger = current_state_->getTriggerTime();
       current_state_->exit(log_);
       current_state_ = new_state;
       current_state_->enter(log_);
+
+      // the transition is complete once the other modules can see the new state
+      now = utils::Timer::getTimeMicros();
+      if (trigger != 0 && trigger <= now) stats.transition_latency.add(now - trigger);
+      data.setStateMachineStats(stats);
+      published = now;
+      continue;     // the new state may be left on the same data
+    }
+
+    if (now - published >= kStatsPeriod) {
+      data.setStateMachineStats(stats);
+      published = now;
     }
 
-    // Yielding because running the loop twice without any other thread being active
-    // will result in identical behaviour and thus waste resources.
-    yield();
+    // checking again before any data changed would give the same result
+    data.waitForUpdates(kTransitionChannels, updates, kUpdateTimeout);
   }
 
+  data.setStateMachineStats(stats);
+  logHistogram("Tick time", stats.tick_time);
+  logHistogram("Transition latency", stats.transition_latency);
+
   data::StateMachine sm_data = data.getStateMachineData();
   log_.INFO(Messages::kStmLoggingIdentifier, Messages::kExitingProgramFormat,
             data::states[sm_data.current_state]);
 }
 
+void Main::logHistogram(const char *name, const utils::math::Histogram &histogram)
+{
+  log_.INFO(Messages::kStmLoggingIdentifier, Messages::kHistogramFormat, name,
+            histogram.getCount(), histogram.getMean(),
+            static_cast<unsigned long>(histogram.getPercentile(0.5)),    // NOLINT [runtime/int]
+            static_cast<unsigned long>(histogram.getPercentile(0.99)),   // NOLINT [runtime/int]
+            static_cast<unsigned long>(histogram.getMax()));             // NOLINT [runtime/int]
+  for (int i = 0; i < utils::math::Histogram::kNumBuckets; i++) {
+    if (histogram.getBucket(i) == 0) continue;
+    log_.INFO(Messages::kStmLoggingIdentifier, Messages::kHistogramBucketFormat, name,
+              static_cast<unsigned long>(utils::math::Histogram::getUpperBound(i)),  // NOLINT
+              histogram.getBucket(i));
+  }
+}
+
 }  // namespace state_machine
 }  // namespace hyped
@@ -27,7 +27,9 @@
 
 #include "data/data.hpp"
 #include "state_machine/state.hpp"
+#include "state_machine/transitions.hpp"
 #include "utils/concurrent/thread.hpp"
+#include "utils/math/histogram.hpp"
 #include "utils/system.hpp"
 
 namespace hyped {
@@ -49,10 +51,23 @@ class Main : public Thread {
    */
   void run() override;
 
+  // data the transitions read, a change of any of it wakes the thread
+  static constexpr uint32_t kTransitionChannels = getTransitionReads();
+  // longest the thread sleeps without any of it changing, bounds how late it sees shutdown
+  static constexpr uint64_t kUpdateTimeout = 100000;   // microseconds
+  // longest the statistics in Data lag behind the thread between transitions
+  static constexpr uint64_t kStatsPeriod = 250000;     // microseconds
+
   /*
    * @brief  Current state of the pod
    */
   State *current_state_;
+
+ private:
+  /*
+   * @brief  Logs the summary and the non-empty buckets of histogram
+   */
+  void logHistogram(const char *name, const utils::math::Histogram &histogram);
 };
 
 }  // namespace state_machine
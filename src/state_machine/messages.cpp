@@ -79,6 +79,15 @@ const char Messages::kExitingProgramFormat[] = "Exiting. Current state: %s";
 
 const char Messages::kTransitionFromOffLog[] = "Tried to transition from Off state";
 
+//--------------------------------------------------------------------------------------
+// Statistics
+//--------------------------------------------------------------------------------------
+
+const char Messages::kHistogramFormat[]
+  = "%s: %u samples, mean %.1f us, median %lu us, 99th percentile %lu us, max %lu us";
+
+const char Messages::kHistogramBucketFormat[] = "%s up to %lu us: %u";
+
 }  // namespace state_machine
 
 }  // namespace hyped
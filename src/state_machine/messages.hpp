@@ -103,6 +103,16 @@ struct Messages {
   // Sent upon trying to transition from Off state
   static const char kTransitionFromOffLog[];
 
+  //--------------------------------------------------------------------------------------
+  // Statistics
+  //--------------------------------------------------------------------------------------
+
+  // Sent upon exiting main loop, once per histogram
+  static const char kHistogramFormat[];
+
+  // Sent upon exiting main loop, once per non-empty bucket of a histogram
+  static const char kHistogramBucketFormat[];
+
   // Messages only exists to hold static members, no constructor is needed.
   Messages() = delete;
 };
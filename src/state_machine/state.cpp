@@ -29,18 +29,135 @@ namespace state_machine {
 //  General State
 //--------------------------------------------------------------------------------------
 
-State::State() : data_(data::Data::getInstance())
+State::State()
+    : data_(data::Data::getInstance()),
+      read_channels_(0),
+      read_updates_(),
+      guard_evaluated_(),
+      guard_results_(),
+      guard_updates_(),
+      guard_evaluations_(0),
+      trigger_time_(0)
 {
 }
 
-void State::updateModuleData()
+State *State::evaluateTransitions(Logger &log, StateId id)
 {
-  embrakes_data_  = data_.getEmergencyBrakesData();
-  nav_data_       = data_.getNavigationData();
-  batteries_data_ = data_.getBatteriesData();
-  telemetry_data_ = data_.getTelemetryData();
-  sensors_data_   = data_.getSensorsData();
-  motors_data_    = data_.getMotorData();
+  // counted before the data is read, so an update while reading shows as a change next time
+  uint32_t channels = getTransitionReads(1u << static_cast<int>(id));
+  uint32_t updates[data::kNumChannels] = {0};
+  for (int i = 0; i < data::kNumChannels; i++) {
+    if (channels & (1u << i)) updates[i] = data_.getUpdates(1u << i);
+  }
+  uint32_t changed = updateModuleData(channels, updates);
+
+  for (int i = 0; i < kNumTransitions; i++) {
+    const Transition &row = kTransitions[i];
+    if (row.from != id) continue;
+
+    // the counts only grow, so their sum changes with any input
+    uint32_t inputs = 0;
+    for (int j = 0; j < data::kNumChannels; j++) {
+      if (row.reads & (1u << j)) inputs += updates[j];
+    }
+    bool evaluated = false;
+    if (!guard_evaluated_[i] || guard_updates_[i] != inputs) {
+      guard_results_[i]   = row.guard(log, module_data_);
+      guard_updates_[i]   = inputs;
+      guard_evaluated_[i] = true;
+      guard_evaluations_++;
+      evaluated = true;
+    }
+    if (guard_results_[i]) {
+      // a guard that turned true now did so on the inputs that changed since the last check
+      trigger_time_ = evaluated ? getTriggerTime(row.reads & changed) : 0;
+      return getState(row.to);
+    }
+  }
+  return nullptr;
+}
+
+uint64_t State::getTriggerTime(uint32_t channels)
+{
+  uint64_t trigger = 0;
+  for (int i = 0; i < data::kNumChannels; i++) {
+    uint32_t channel = 1u << i;
+    if (!(channels & channel)) continue;
+
+    uint64_t time = data_.getUpdateTime(channel);
+    if (channel == data::kChannelNavigation && module_data_.nav_data.timestamp != 0) {
+      // the stamp holds the low bits of the clock, its age is exact as long as it is below an hour
+      uint64_t now = utils::Timer::getTimeMicros();
+      uint32_t age = static_cast<uint32_t>(now) - module_data_.nav_data.timestamp;
+      time = now - age;
+    }
+    if (trigger == 0 || time < trigger) trigger = time;
+  }
+  return trigger;
+}
+
+uint32_t State::updateModuleData(uint32_t channels, const uint32_t *updates)
+{
+  uint32_t changed = 0;
+  for (int i = 0; i < data::kNumChannels; i++) {
+    uint32_t channel = 1u << i;
+    if (!(channels & channel)) continue;
+    if ((read_channels_ & channel) && read_updates_[i] == updates[i]) continue;
+
+    switch (channel) {
+      case data::kChannelEmergencyBrakes:
+        module_data_.embrakes_data = data_.getEmergencyBrakesData();
+        break;
+      case data::kChannelNavigation:
+        module_data_.nav_data = data_.getNavigationData();
+        break;
+      case data::kChannelBatteries:
+        module_data_.batteries_data = data_.getBatteriesData();
+        break;
+      case data::kChannelTelemetry:
+        module_data_.telemetry_data = data_.getTelemetryData();
+        break;
+      case data::kChannelSensors:
+        module_data_.sensors_data = data_.getSensorsData();
+        break;
+      case data::kChannelMotors:
+        module_data_.motors_data = data_.getMotorData();
+        break;
+      default:
+        break;
+    }
+    read_channels_  |= channel;
+    read_updates_[i] = updates[i];
+    changed         |= channel;
+  }
+  return changed;
+}
+
+State *State::getState(StateId id)
+{
+  switch (id) {
+    case StateId::kIdle:
+      return Idle::getInstance();
+    case StateId::kCalibrating:
+      return Calibrating::getInstance();
+    case StateId::kReady:
+      return Ready::getInstance();
+    case StateId::kAccelerating:
+      return Accelerating::getInstance();
+    case StateId::kCruising:
+      return Cruising::getInstance();
+    case StateId::kNominalBraking:
+      return NominalBraking::getInstance();
+    case StateId::kFinished:
+      return Finished::getInstance();
+    case StateId::kFailureBraking:
+      return FailureBraking::getInstance();
+    case StateId::kFailureStopped:
+      return FailureStopped::getInstance();
+    case StateId::kOff:
+      return Off::getInstance();
+  }
+  return nullptr;
 }
 
 //--------------------------------------------------------------------------------------
@@ -51,24 +168,6 @@ Idle Idle::instance_;
 data::State Idle::enum_value_       = data::kIdle;
 char Idle::string_representation_[] = "Idle";
 
-State *Idle::checkTransition(Logger &log)
-{
-  updateModuleData();
-
-  bool emergency = checkEmergency(log, embrakes_data_, nav_data_, batteries_data_, telemetry_data_,
-                                  sensors_data_, motors_data_);
-  if (emergency) { return FailureStopped::getInstance(); }
-
-  bool calibrate_command = checkCalibrateCommand(log, telemetry_data_);
-  if (!calibrate_command) { return nullptr; }
-
-  bool all_initialised = checkModulesInitialised(log, embrakes_data_, nav_data_, batteries_data_,
-                                                 telemetry_data_, sensors_data_, motors_data_);
-  if (all_initialised) { return Calibrating::getInstance(); }
-
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Calibrating
 //--------------------------------------------------------------------------------------
@@ -77,21 +176,6 @@ Calibrating Calibrating::instance_;
 data::State Calibrating::enum_value_       = data::kCalibrating;
 char Calibrating::string_representation_[] = "Calibrating";
 
-State *Calibrating::checkTransition(Logger &log)
-{
-  updateModuleData();
-
-  bool emergency = checkEmergency(log, embrakes_data_, nav_data_, batteries_data_, telemetry_data_,
-                                  sensors_data_, motors_data_);
-  if (emergency) { return FailureStopped::getInstance(); }
-
-  bool all_ready = checkModulesReady(log, embrakes_data_, nav_data_, batteries_data_,
-                                     telemetry_data_, sensors_data_, motors_data_);
-  if (all_ready) { return Ready::getInstance(); }
-
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Ready
 //--------------------------------------------------------------------------------------
@@ -100,20 +184,6 @@ Ready Ready::instance_;
 data::State Ready::enum_value_       = data::kReady;
 char Ready::string_representation_[] = "Ready";
 
-State *Ready::checkTransition(Logger &log)
-{
-  updateModuleData();
-
-  bool emergency = checkEmergency(log, embrakes_data_, nav_data_, batteries_data_, telemetry_data_,
-                                  sensors_data_, motors_data_);
-  if (emergency) { return FailureStopped::getInstance(); }
-
-  bool recieved_launch_command = checkLaunchCommand(log, telemetry_data_);
-  if (recieved_launch_command) { return Accelerating::getInstance(); }
-
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Accelerating
 //--------------------------------------------------------------------------------------
@@ -122,23 +192,6 @@ Accelerating Accelerating::instance_;
 data::State Accelerating::enum_value_       = data::kAccelerating;
 char Accelerating::string_representation_[] = "Accelerating";
 
-State *Accelerating::checkTransition(Logger &log)
-{
-  updateModuleData();
-
-  bool emergency = checkEmergency(log, embrakes_data_, nav_data_, batteries_data_, telemetry_data_,
-                                  sensors_data_, motors_data_);
-  if (emergency) { return FailureBraking::getInstance(); }
-
-  bool in_braking_zone = checkEnteredBrakingZone(log, nav_data_);
-  if (in_braking_zone) { return NominalBraking::getInstance(); }
-
-  bool reached_max_velocity = checkReachedMaxVelocity(log, nav_data_);
-  if (reached_max_velocity) { return Cruising::getInstance(); }
-
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Cruising
 //--------------------------------------------------------------------------------------
@@ -147,20 +200,6 @@ Cruising Cruising::instance_;
 data::State Cruising::enum_value_       = data::kCruising;
 char Cruising::string_representation_[] = "Cruising";
 
-State *Cruising::checkTransition(Logger &log)
-{
-  updateModuleData();
-
-  bool emergency = checkEmergency(log, embrakes_data_, nav_data_, batteries_data_, telemetry_data_,
-                                  sensors_data_, motors_data_);
-  if (emergency) { return FailureBraking::getInstance(); }
-
-  bool in_braking_zone = checkEnteredBrakingZone(log, nav_data_);
-  if (in_braking_zone) { return NominalBraking::getInstance(); }
-
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Nominal Braking
 //--------------------------------------------------------------------------------------
@@ -169,19 +208,6 @@ NominalBraking NominalBraking::instance_;
 data::State NominalBraking::enum_value_       = data::kNominalBraking;
 char NominalBraking::string_representation_[] = "NominalBraking";
 
-State *NominalBraking::checkTransition(Logger &log)
-{
-  updateModuleData();
-
-  bool emergency = checkEmergency(log, embrakes_data_, nav_data_, batteries_data_, telemetry_data_,
-                                  sensors_data_, motors_data_);
-  if (emergency) { return FailureBraking::getInstance(); }
-
-  bool stopped = checkPodStopped(log, nav_data_);
-  if (stopped) { return Finished::getInstance(); }
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Finished
 //--------------------------------------------------------------------------------------
@@ -190,16 +216,6 @@ Finished Finished::instance_;
 data::State Finished::enum_value_       = data::kFinished;
 char Finished::string_representation_[] = "Finished";
 
-State *Finished::checkTransition(Logger &log)
-{
-  // We only need to update telemetry data.
-  telemetry_data_ = data_.getTelemetryData();
-
-  bool received_shutdown_command = checkShutdownCommand(log, telemetry_data_);
-  if (received_shutdown_command) { return Off::getInstance(); }
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  FailureBraking
 //--------------------------------------------------------------------------------------
@@ -208,16 +224,6 @@ FailureBraking FailureBraking::instance_;
 data::State FailureBraking::enum_value_       = data::kEmergencyBraking;
 char FailureBraking::string_representation_[] = "FailureBraking";
 
-State *FailureBraking::checkTransition(Logger &log)
-{
-  // We only need to update navigation data.
-  nav_data_ = data_.getNavigationData();
-
-  bool stopped = checkPodStopped(log, nav_data_);
-  if (stopped) { return FailureStopped::getInstance(); }
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  FailureStopped
 //--------------------------------------------------------------------------------------
@@ -226,16 +232,6 @@ FailureStopped FailureStopped::instance_;
 data::State FailureStopped::enum_value_       = data::kFailureStopped;
 char FailureStopped::string_representation_[] = "FailureStopped";
 
-State *FailureStopped::checkTransition(Logger &log)
-{
-  // We only need to update telemetry data.
-  telemetry_data_ = data_.getTelemetryData();
-
-  bool received_shutdown_command = checkShutdownCommand(log, telemetry_data_);
-  if (received_shutdown_command) { return Off::getInstance(); }
-  return nullptr;
-}
-
 //--------------------------------------------------------------------------------------
 //  Off
 //--------------------------------------------------------------------------------------
@@ -23,6 +23,8 @@
 #ifndef STATE_MACHINE_STATE_HPP_
 #define STATE_MACHINE_STATE_HPP_
 
+#include <cstdint>
+
 #include "data/data.hpp"
 #include "state_machine/main.hpp"
 #include "state_machine/messages.hpp"
@@ -50,16 +52,52 @@ class State {
 
   virtual State *checkTransition(Logger &log) = 0;
 
+  /*
+   * @brief   Returns the number of guards evaluated so far by this state.
+   */
+  uint32_t getGuardEvaluations() const { return guard_evaluations_; }
+
+  /*
+   * @brief   Returns the time of utils::Timer of the data that made checkTransition return the
+   *          last new state, 0 if unknown.
+   */
+  uint64_t getTriggerTime() const { return trigger_time_; }
+
   data::Data &data_;
 
  protected:
-  data::EmergencyBrakes embrakes_data_;
-  data::Navigation nav_data_;
-  data::Batteries batteries_data_;
-  data::Telemetry telemetry_data_;
-  data::Sensors sensors_data_;
-  data::Motors motors_data_;
-  void updateModuleData();
+  ModuleData module_data_;
+
+  /*
+   * @brief   Returns the target of the first row of kTransitions leaving id whose guard holds,
+   *          or nullptr. Only the data the rows declare is read, and only if it was updated.
+   *          A guard whose inputs were not updated since it last ran keeps its result.
+   */
+  State *evaluateTransitions(Logger &log, StateId id);
+
+ private:
+  static State *getState(StateId id);
+
+  /*
+   * @brief   Reads the structs of channels that were updated since they were last read.
+   *          Returns the channels it read.
+   */
+  uint32_t updateModuleData(uint32_t channels, const uint32_t *updates);
+
+  /*
+   * @brief   Returns when the data of channels was produced, the earliest of them so that the
+   *          latency is not understated, 0 for no channels. Navigation stamps its data with the
+   *          time of the sensor data it is computed from, other data counts from when it was set.
+   */
+  uint64_t getTriggerTime(uint32_t channels);
+
+  uint32_t read_channels_;                        // read at least once
+  uint32_t read_updates_[data::kNumChannels];     // update counts of the structs when read
+  bool guard_evaluated_[kNumTransitions];
+  bool guard_results_[kNumTransitions];
+  uint32_t guard_updates_[kNumTransitions];       // update counts of the inputs when evaluated
+  uint32_t guard_evaluations_;
+  uint64_t trigger_time_;
 };
 
 class Messages;
@@ -73,7 +111,7 @@ class Messages;
     S() {}                                                                                         \
     static S *getInstance() { return &S::instance_; }                                              \
                                                                                                    \
-    State *checkTransition(Logger &log);                                                           \
+    State *checkTransition(Logger &log) { return evaluateTransitions(log, StateId::k##S); }        \
     /* @brief   Prints log message and sets appropriate public enum value.*/                       \
     void enter(Logger &log)                                                                        \
     {                                                                                              \
@@ -126,6 +164,7 @@ class Off : public State {
     log.INFO(Messages::kStmLoggingIdentifier, Messages::kShutdownLog);
     utils::System &sys = utils::System::getSystem();
     sys.running_       = false;
+    sys.navigation_motors_sync_.cancel();
   }
 
   void exit(Logger &log)
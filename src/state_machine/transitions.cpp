@@ -152,6 +152,138 @@ bool checkPodStopped(Logger &log, Navigation &nav_data)
   return true;
 }
 
+//--------------------------------------------------------------------------------------
+// Transition Table
+//--------------------------------------------------------------------------------------
+
+bool guardEmergency(Logger &log, ModuleData &module_data)
+{
+  return checkEmergency(log, module_data.embrakes_data, module_data.nav_data,
+                        module_data.batteries_data, module_data.telemetry_data,
+                        module_data.sensors_data, module_data.motors_data);
+}
+
+bool guardCalibrate(Logger &log, ModuleData &module_data)
+{
+  if (!checkCalibrateCommand(log, module_data.telemetry_data)) return false;
+
+  return checkModulesInitialised(log, module_data.embrakes_data, module_data.nav_data,
+                                 module_data.batteries_data, module_data.telemetry_data,
+                                 module_data.sensors_data, module_data.motors_data);
+}
+
+bool guardModulesReady(Logger &log, ModuleData &module_data)
+{
+  return checkModulesReady(log, module_data.embrakes_data, module_data.nav_data,
+                           module_data.batteries_data, module_data.telemetry_data,
+                           module_data.sensors_data, module_data.motors_data);
+}
+
+bool guardLaunch(Logger &log, ModuleData &module_data)
+{
+  return checkLaunchCommand(log, module_data.telemetry_data);
+}
+
+bool guardBrakingZone(Logger &log, ModuleData &module_data)
+{
+  return checkEnteredBrakingZone(log, module_data.nav_data);
+}
+
+bool guardMaxVelocity(Logger &log, ModuleData &module_data)
+{
+  return checkReachedMaxVelocity(log, module_data.nav_data);
+}
+
+bool guardStopped(Logger &log, ModuleData &module_data)
+{
+  return checkPodStopped(log, module_data.nav_data);
+}
+
+bool guardShutdown(Logger &log, ModuleData &module_data)
+{
+  return checkShutdownCommand(log, module_data.telemetry_data);
+}
+
+/*
+ * The graph is checked when this file is compiled, a broken table does not build.
+ */
+namespace {
+
+constexpr uint32_t bit(StateId id)
+{
+  return 1u << static_cast<int>(id);
+}
+
+constexpr uint32_t kAllStates = (1u << kNumStateIds) - 1;
+
+constexpr bool isRowValid(const Transition &row)
+{
+  return row.from != row.to && row.from != StateId::kOff && row.reads != 0
+         && (row.reads & ~kModuleChannels) == 0 && row.guard != nullptr;
+}
+
+constexpr bool areRowsValid(int i = 0)
+{
+  return i == kNumTransitions || (isRowValid(kTransitions[i]) && areRowsValid(i + 1));
+}
+
+// true iff a row before i leaves from
+constexpr bool isLeftBefore(StateId from, int i)
+{
+  return i > 0 && (kTransitions[i - 1].from == from || isLeftBefore(from, i - 1));
+}
+
+constexpr bool areRowsGrouped(int i = 1)
+{
+  return i >= kNumTransitions
+         || ((kTransitions[i].from == kTransitions[i - 1].from
+              || !isLeftBefore(kTransitions[i].from, i))
+             && areRowsGrouped(i + 1));
+}
+
+constexpr bool isEmergencyFirst(int i = 0)
+{
+  return i == kNumTransitions
+         || ((kTransitions[i].guard != &guardEmergency || i == 0
+              || kTransitions[i - 1].from != kTransitions[i].from)
+             && isEmergencyFirst(i + 1));
+}
+
+constexpr uint32_t getLeftStates(int i = 0)
+{
+  return i == kNumTransitions ? 0 : bit(kTransitions[i].from) | getLeftStates(i + 1);
+}
+
+// states reached from mask in one transition, or leading to it if backwards
+constexpr uint32_t step(uint32_t mask, bool backwards, int i = 0)
+{
+  return i == kNumTransitions
+           ? mask
+           : step(mask | (backwards ? ((mask & bit(kTransitions[i].to)) ? bit(kTransitions[i].from)
+                                                                        : 0)
+                                    : ((mask & bit(kTransitions[i].from)) ? bit(kTransitions[i].to)
+                                                                          : 0)),
+                  backwards, i + 1);
+}
+
+constexpr uint32_t getClosure(uint32_t mask, bool backwards, int steps = kNumStateIds)
+{
+  return steps == 0 ? mask : getClosure(step(mask, backwards), backwards, steps - 1);
+}
+
+static_assert(areRowsValid(), "a transition must change state, declare what it reads and not "
+                              "leave Off");
+static_assert(areRowsGrouped(), "the transitions leaving a state must be listed together");
+static_assert(isEmergencyFirst(), "emergencies must be checked before any other transition");
+static_assert(getLeftStates() == (kAllStates & ~bit(StateId::kOff)),
+              "every state but Off must have a transition");
+static_assert(getClosure(bit(StateId::kIdle), false) == kAllStates,
+              "every state must be reachable from Idle");
+static_assert(getClosure(bit(StateId::kOff), true) == kAllStates,
+              "Off must be reachable from every state");
+
+}  // namespace
+
 }  // namespace state_machine
 
 }  // namespace hyped
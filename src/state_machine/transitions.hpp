@@ -23,8 +23,9 @@
 #ifndef STATE_MACHINE_TRANSITIONS_HPP_
 #define STATE_MACHINE_TRANSITIONS_HPP_
 
+#include <cstdint>
+
 #include "data/data.hpp"
-#include "state_machine/state.hpp"
 #include "utils/logger.hpp"
 
 namespace hyped {
@@ -33,6 +34,7 @@ namespace state_machine {
 
 using hyped::data::Batteries;
 using hyped::data::EmergencyBrakes;
+using hyped::data::ModuleStatus;
 using hyped::data::Motors;
 using hyped::data::Navigation;
 using hyped::data::Sensors;
@@ -108,6 +110,111 @@ bool checkReachedMaxVelocity(Logger &log, Navigation &nav_data);
  * @brief   Returns true iff the pod has reached zero velocity.
  */
 bool checkPodStopped(Logger &log, Navigation &nav_data);
+
+//--------------------------------------------------------------------------------------
+// Transition Table
+//--------------------------------------------------------------------------------------
+
+/*
+ * @brief   Vertices of the transition graph, one per state including Off.
+ */
+enum class StateId : uint8_t {
+  kIdle,
+  kCalibrating,
+  kReady,
+  kAccelerating,
+  kCruising,
+  kNominalBraking,
+  kFinished,
+  kFailureBraking,
+  kFailureStopped,
+  kOff,
+};
+constexpr int kNumStateIds = 10;
+
+/*
+ * @brief   The data the guards of the transitions are evaluated on.
+ */
+struct ModuleData {
+  EmergencyBrakes embrakes_data;
+  Navigation nav_data;
+  Batteries batteries_data;
+  Telemetry telemetry_data;
+  Sensors sensors_data;
+  Motors motors_data;
+};
+
+/*
+ * @brief   Returns true iff the transition is to be taken. Must only depend on the fields of
+ *          module_data its row declares, so its result can be kept while they are unchanged.
+ */
+typedef bool (*Guard)(Logger &log, ModuleData &module_data);
+
+bool guardEmergency(Logger &log, ModuleData &module_data);
+bool guardCalibrate(Logger &log, ModuleData &module_data);  // command and modules initialised
+bool guardModulesReady(Logger &log, ModuleData &module_data);
+bool guardLaunch(Logger &log, ModuleData &module_data);
+bool guardBrakingZone(Logger &log, ModuleData &module_data);
+bool guardMaxVelocity(Logger &log, ModuleData &module_data);
+bool guardStopped(Logger &log, ModuleData &module_data);
+bool guardShutdown(Logger &log, ModuleData &module_data);
+
+struct Transition {
+  StateId from;
+  uint32_t reads;  // data::Channel of every struct the guard reads
+  Guard guard;
+  StateId to;
+};
+
+constexpr uint32_t kModuleChannels = data::kChannelEmergencyBrakes | data::kChannelNavigation
+                                     | data::kChannelBatteries | data::kChannelTelemetry
+                                     | data::kChannelSensors | data::kChannelMotors;
+
+/*
+ * @brief   Every transition of the state machine. The rows leaving a state are checked in order
+ *          and the first guard that holds wins, so emergencies come first.
+ */
+constexpr Transition kTransitions[] = {
+  {StateId::kIdle, kModuleChannels, &guardEmergency, StateId::kFailureStopped},
+  {StateId::kIdle, kModuleChannels, &guardCalibrate, StateId::kCalibrating},
+
+  {StateId::kCalibrating, kModuleChannels, &guardEmergency, StateId::kFailureStopped},
+  {StateId::kCalibrating, kModuleChannels, &guardModulesReady, StateId::kReady},
+
+  {StateId::kReady, kModuleChannels, &guardEmergency, StateId::kFailureStopped},
+  {StateId::kReady, data::kChannelTelemetry, &guardLaunch, StateId::kAccelerating},
+
+  {StateId::kAccelerating, kModuleChannels, &guardEmergency, StateId::kFailureBraking},
+  {StateId::kAccelerating, data::kChannelNavigation, &guardBrakingZone, StateId::kNominalBraking},
+  {StateId::kAccelerating, data::kChannelNavigation, &guardMaxVelocity, StateId::kCruising},
+
+  {StateId::kCruising, kModuleChannels, &guardEmergency, StateId::kFailureBraking},
+  {StateId::kCruising, data::kChannelNavigation, &guardBrakingZone, StateId::kNominalBraking},
+
+  {StateId::kNominalBraking, kModuleChannels, &guardEmergency, StateId::kFailureBraking},
+  {StateId::kNominalBraking, data::kChannelNavigation, &guardStopped, StateId::kFinished},
+
+  {StateId::kFinished, data::kChannelTelemetry, &guardShutdown, StateId::kOff},
+
+  {StateId::kFailureBraking, data::kChannelNavigation, &guardStopped, StateId::kFailureStopped},
+
+  {StateId::kFailureStopped, data::kChannelTelemetry, &guardShutdown, StateId::kOff},
+};
+constexpr int kNumTransitions = sizeof(kTransitions) / sizeof(Transition);
+
+/*
+ * @brief   Returns the channels the guards of rows i and after read, from_mask selects the
+ *          states they leave by bit of StateId.
+ */
+constexpr uint32_t getTransitionReads(uint32_t from_mask = ~0u, int i = 0)
+{
+  return i == kNumTransitions
+           ? 0
+           : ((from_mask >> static_cast<int>(kTransitions[i].from) & 1u) ? kTransitions[i].reads
+                                                                         : 0)
+               | getTransitionReads(from_mask, i + 1);
+}
+
 }  // namespace state_machine
 
 }  // namespace hyped
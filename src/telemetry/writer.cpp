@@ -21,10 +21,15 @@
 
 #include <chrono>
 #include <cstdint>
+#include <cstdio>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include "writer.hpp"
 #include "data/data.hpp"
+#include "utils/io/can.hpp"
+#include "utils/timer.hpp"
 
 namespace hyped {
 namespace telemetry {
@@ -47,7 +52,8 @@ void Writer::packAdditionalData()
   rjwriter_.StartArray();
 
   // edit below
-
+  addCanStats();
+  addStateMachineStats();
   // edit above
 
   rjwriter_.EndArray();
@@ -82,6 +88,55 @@ void Writer::packStatusData()
   rjwriter_.EndArray();
 }
 
+void Writer::addCanStats()
+{
+  constexpr int kMaxCount = std::numeric_limits<int>::max();
+  uint64_t now = utils::Timer::getTimeMicros();
+
+  for (utils::io::Can* bus : utils::io::Can::getInstances()) {
+    utils::io::can::BusStats stats = bus->getStats();
+    char name[32];
+    snprintf(name, sizeof(name), "CAN %s", bus->getInterface());
+    startList(name);
+    add("utilisation", 0.0f, 100.0f, "%", static_cast<float>(stats.utilisation * 100));
+    add("received", 0, kMaxCount, "frames", static_cast<int>(stats.rx_frames));
+    add("sent", 0, kMaxCount, "frames", static_cast<int>(stats.tx_frames));
+    add("error frames", 0, kMaxCount, "frames", static_cast<int>(stats.error_frames));
+
+    for (const utils::io::can::IdStats& id : stats.ids) {
+      snprintf(name, sizeof(name), "0x%X%s", id.id, id.extended ? " ext" : "");
+      startList(name);
+      float rate = id.mean_interval > 0 ? 1e6 / id.mean_interval : 0;
+      add("rate", 0.0f, 10000.0f, "Hz", rate);
+      add("jitter", 0.0f, 100000.0f, "us", static_cast<float>(id.jitter));
+      add("last seen", 0.0f, 10000.0f, "ms", (now - id.last_seen) / 1000.0f);
+      add("tx errors", 0, kMaxCount, "", static_cast<int>(id.tx_errors));
+      endList();
+    }
+    endList();
+  }
+}
+
+void Writer::addStateMachineStats()
+{
+  constexpr int kMaxCount = std::numeric_limits<int>::max();
+  data::StateMachineStats stats = data_.getStateMachineStats();
+
+  startList("State machine");
+  add("ticks", 0, kMaxCount, "", static_cast<int>(stats.tick_time.getCount()));
+  add("tick p50", 0.0f, 10000.0f, "us", static_cast<float>(stats.tick_time.getPercentile(0.5)));
+  add("tick p99", 0.0f, 10000.0f, "us", static_cast<float>(stats.tick_time.getPercentile(0.99)));
+  add("tick max", 0.0f, 10000.0f, "us", static_cast<float>(stats.tick_time.getMax()));
+  add("transitions", 0, kMaxCount, "", static_cast<int>(stats.transition_latency.getCount()));
+  add("latency p50", 0.0f, 100000.0f, "us",
+      static_cast<float>(stats.transition_latency.getPercentile(0.5)));
+  add("latency p99", 0.0f, 100000.0f, "us",
+      static_cast<float>(stats.transition_latency.getPercentile(0.99)));
+  add("latency max", 0.0f, 100000.0f, "us",
+      static_cast<float>(stats.transition_latency.getMax()));
+  endList();
+}
+
 Writer::Writer(data::Data& data)
   : rjwriter_(sb_),
     data_ {data}
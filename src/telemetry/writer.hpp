@@ -86,6 +86,12 @@ class Writer {
   void add(const char* name, data::State value);
   void add(const char* name, data::ModuleStatus value);
 
+  // adds a list per CAN bus with its load and the rate of every CAN id seen
+  void addCanStats();
+
+  // adds a list with the tick time and transition latency of the state machine
+  void addStateMachineStats();
+
   // starts and ends lists, which allow to structure the data
   void startList(const char* name);
   void endList();
@@ -0,0 +1,197 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Real, manually advanced and simulated clocks
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "utils/clock.hpp"
+
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "utils/concurrent/lock.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+
+Clock& Clock::getSystemClock()
+{
+  static SystemClock clock;
+  return clock;
+}
+
+uint64_t SystemClock::getTimeMicros()
+{
+  return Timer::getTimeMicros();
+}
+
+void SystemClock::sleep(uint64_t micros)
+{
+  usleep(micros);
+}
+
+struct SimulationClock::Participant {
+  uint64_t                wake      = 0;
+  uint64_t                sequence  = 0;
+  const void*             channel   = nullptr;
+  bool                    queued    = false;
+  bool                    notified  = false;
+  std::condition_variable turn;
+};
+
+constexpr uint64_t SimulationClock::kForever;
+std::atomic<SimulationClock*> SimulationClock::installed_(nullptr);
+thread_local SimulationClock::Participant* SimulationClock::current_ = nullptr;
+
+SimulationClock::SimulationClock(uint64_t start, uint64_t yield_time)
+    : now_(start),
+      yield_time_(yield_time),
+      sequence_(0),
+      switches_(0),
+      running_(nullptr)
+{}
+
+SimulationClock::~SimulationClock()
+{
+  uninstall();
+  for (Participant* participant : participants_) delete participant;
+}
+
+void SimulationClock::sleep(uint64_t micros)
+{
+  wait(nullptr, micros);
+}
+
+bool SimulationClock::wait(const void* channel, uint64_t micros)
+{
+  return wait(channel, micros, nullptr);
+}
+
+bool SimulationClock::wait(const void* channel, uint64_t micros, concurrent::Lock* user_lock)
+{
+  // a thread outside the simulation waits as a participant, the clock would not move otherwise
+  bool attached = isAttached();
+  if (!attached) attach();
+  Participant* participant = current_;
+
+  // waiting for no time would keep the turn at the same time, a polling loop would stop the clock
+  if (micros == 0) micros = yield_time_;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  participant->wake     = micros < kForever - now_ ? now_ + micros : kForever;
+  participant->channel  = channel;
+  participant->notified = false;
+  enqueue(participant);
+  if (user_lock) user_lock->unlock();
+  schedule();
+  while (running_ != participant) participant->turn.wait(lock);
+  participant->channel = nullptr;
+  bool notified = participant->notified;
+  lock.unlock();
+
+  if (!attached) detach();
+  if (user_lock) user_lock->lock();
+  return notified;
+}
+
+void SimulationClock::notify(const void* channel)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Participant* participant : participants_) {
+    if (!participant->queued || participant->channel != channel) continue;
+    participant->channel  = nullptr;
+    participant->notified = true;
+    participant->wake     = now_;
+    participant->sequence = sequence_++;
+  }
+  // notified from outside the simulation while every thread waited
+  if (!running_) schedule();
+}
+
+SimulationClock::Participant* SimulationClock::reserve()
+{
+  Participant* participant = new Participant();
+  std::lock_guard<std::mutex> lock(mutex_);
+  participants_.push_back(participant);
+  participant->wake = now_;
+  enqueue(participant);
+  if (!running_) schedule();
+  return participant;
+}
+
+void SimulationClock::attach(Participant* participant)
+{
+  if (!participant) participant = reserve();
+  current_ = participant;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_ != participant) participant->turn.wait(lock);
+}
+
+void SimulationClock::detach()
+{
+  Participant* participant = current_;
+  if (!participant) return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  participants_.erase(std::find(participants_.begin(), participants_.end(), participant));
+  if (running_ == participant) {
+    running_ = nullptr;
+    schedule();
+  }
+  delete participant;
+  current_ = nullptr;
+}
+
+void SimulationClock::install()
+{
+  installed_ = this;
+}
+
+void SimulationClock::uninstall()
+{
+  SimulationClock* clock = this;
+  installed_.compare_exchange_strong(clock, nullptr);
+}
+
+void SimulationClock::enqueue(Participant* participant)
+{
+  participant->queued   = true;
+  participant->sequence = sequence_++;
+}
+
+void SimulationClock::schedule()
+{
+  Participant* next = nullptr;
+  for (Participant* participant : participants_) {
+    if (!participant->queued) continue;
+    bool earlier = !next || participant->wake < next->wake
+                   || (participant->wake == next->wake && participant->sequence < next->sequence);
+    if (earlier) next = participant;
+  }
+  if (next != running_) switches_++;
+
+  // everyone waits for a notification, only a thread outside the simulation can give it
+  if (!next || next->wake == kForever) {
+    running_ = nullptr;
+    return;
+  }
+  if (next->wake > now_) now_ = next->wake;
+  next->queued = false;
+  running_     = next;
+  next->turn.notify_one();
+}
+
+}}  // namespace hyped::utils
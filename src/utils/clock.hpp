@@ -0,0 +1,200 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Source of time that can be injected into code which would otherwise read Timer directly.
+ * SystemClock is the time base of Timer::getTimeMicros(). ManualClock only moves when told to,
+ * so simulations run faster than real time and repeat exactly. SimulationClock does the same for
+ * the whole system: once installed, Timer, Thread and ConditionVariable follow it, and the threads
+ * take turns in the order of the times they wait for.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef UTILS_CLOCK_HPP_
+#define UTILS_CLOCK_HPP_
+
+#include <condition_variable>
+#include <mutex>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "utils/utils.hpp"
+
+namespace hyped {
+namespace utils {
+
+namespace concurrent { class Lock; }
+
+class Clock {
+ public:
+  virtual ~Clock() {}
+
+  /**
+   * @return microseconds, the same time base as Timer::getTimeMicros() for SystemClock
+   */
+  virtual uint64_t getTimeMicros() = 0;
+
+  /**
+   * @brief Let micros pass on this clock
+   */
+  virtual void sleep(uint64_t micros) = 0;
+
+  /**
+   * @return process wide SystemClock
+   */
+  static Clock& getSystemClock();
+};
+
+class SystemClock : public Clock {
+ public:
+  SystemClock() {}
+  uint64_t getTimeMicros() override;
+  void sleep(uint64_t micros) override;
+
+ private:
+  NO_COPY_ASSIGN(SystemClock);
+};
+
+class ManualClock : public Clock {
+ public:
+  explicit ManualClock(uint64_t start = 0) : now_(start) {}
+  uint64_t getTimeMicros() override { return now_; }
+
+  /**
+   * @brief Advances the clock instead of waiting
+   */
+  void sleep(uint64_t micros) override { now_ += micros; }
+
+  void advance(uint64_t micros) { now_ += micros; }
+  void set(uint64_t micros) { now_ = micros; }
+
+ private:
+  std::atomic<uint64_t> now_;
+  NO_COPY_ASSIGN(ManualClock);
+};
+
+/**
+ * @brief Virtual time for every thread of the process. Only one attached thread runs at a time,
+ * until it sleeps or waits. The next turn goes to the thread waiting for the earliest time, ties
+ * in the order the threads started to wait, and the clock jumps to that time. So a run takes as
+ * long as its computation, not its sleeps, and with the same inputs it takes the same turns.
+ *
+ * Threads started while a clock is installed are attached to it. A thread that neither sleeps,
+ * yields nor waits on a ConditionVariable keeps its turn and stops the clock.
+ */
+class SimulationClock : public Clock {
+ public:
+  struct Participant;
+
+  static constexpr uint64_t kForever = UINT64_MAX;
+
+  /**
+   * @param start      - initial time, several modules take a timestamp of 0 as not set
+   * @param yield_time - time that passes on Thread::yield() or a wait of no time, a busy loop on
+   *                     the pod runs as often as the CPU allows, in a simulation once per yield
+   */
+  explicit SimulationClock(uint64_t start = 0, uint64_t yield_time = 1000);
+  ~SimulationClock();
+
+  uint64_t getTimeMicros() override { return now_; }
+
+  /**
+   * @brief Gives up the turn until micros passed
+   */
+  void sleep(uint64_t micros) override;
+
+  /**
+   * @brief Gives up the turn until micros passed or channel is notified
+   * @param channel - any address identifying what is waited for, e.g. a ConditionVariable
+   * @return true iff channel was notified
+   */
+  bool wait(const void* channel, uint64_t micros);
+
+  /**
+   * @brief As above, releasing lock only once the wait is registered, so that a notify from a
+   * thread outside the simulation cannot fall in between. lock is held again on return.
+   */
+  bool wait(const void* channel, uint64_t micros, concurrent::Lock* lock);
+
+  /**
+   * @brief Lets the threads waiting on channel run at the current time, after the caller waits
+   */
+  void notify(const void* channel);
+
+  /**
+   * @brief Makes a place in the schedule for a thread about to be started, so that the clock does
+   * not move on before the thread attaches
+   */
+  Participant* reserve();
+
+  /**
+   * @brief Adds the calling thread to the schedule and returns once it has its turn
+   * @param participant - place made by reserve(), a new one if nullptr
+   */
+  void attach(Participant* participant = nullptr);
+
+  /**
+   * @brief Removes the calling thread from the schedule and hands on its turn
+   */
+  void detach();
+
+  /**
+   * @return true iff the calling thread is attached
+   */
+  bool isAttached() const { return current_ != nullptr; }
+
+  /**
+   * @return number of turns handed from one thread to another
+   */
+  uint64_t getSwitches() const { return switches_; }
+
+  /**
+   * @brief Makes this the time of Timer::getTimeMicros(), Thread and ConditionVariable. The time
+   * jumps from real to virtual time here and back on uninstall(), so an interval taken across
+   * either is meaningless. Install before starting the threads of a simulation and uninstall
+   * after joining them.
+   */
+  void install();
+  void uninstall();
+
+  /**
+   * @return installed clock, nullptr outside of simulations
+   */
+  static SimulationClock* getInstalled() { return installed_; }
+
+ private:
+  void enqueue(Participant* participant);
+
+  /**
+   * @brief Hands the turn to the participant waiting for the earliest time, mutex_ must be held
+   */
+  void schedule();
+
+  std::mutex                        mutex_;
+  std::atomic<uint64_t>             now_;
+  uint64_t                          yield_time_;
+  uint64_t                          sequence_;
+  std::atomic<uint64_t>             switches_;
+  std::vector<Participant*>         participants_;
+  Participant*                      running_;
+
+  static std::atomic<SimulationClock*>  installed_;
+  static thread_local Participant*      current_;
+  NO_COPY_ASSIGN(SimulationClock);
+};
+
+}}  // namespace hyped::utils
+
+#endif  // UTILS_CLOCK_HPP_
@@ -20,29 +20,112 @@
 
 #include "utils/concurrent/barrier.hpp"
 
+#include <algorithm>
+
+#include "utils/timer.hpp"
 
 namespace hyped {
 namespace utils {
 namespace concurrent {
 
-Barrier::Barrier(uint8_t required)
+// requestCancel() is called from signal handlers
+static_assert(ATOMIC_BOOL_LOCK_FREE == 2, "std::atomic<bool> must be lock-free");
+
+constexpr uint64_t Barrier::kCancelPoll;
+
+Barrier::Barrier(uint8_t required, uint32_t spin)
     : required_(required),
-      calls_(0)
+      calls_(0),
+      spin_(spin),
+      generation_(0),
+      cancelled_(false),
+      cancel_requested_(false)
 { /* EMPTY */ }
 
 Barrier::~Barrier() { /* EMPTY */ }
 
-void Barrier::wait()
+bool Barrier::wait()
+{
+  return await(false, 0);
+}
+
+bool Barrier::waitFor(uint64_t timeout_micros)
+{
+  return await(true, timeout_micros);
+}
+
+bool Barrier::await(bool timed, uint64_t timeout_micros)
 {
+  uint64_t deadline = Timer::getTimeMicros() + timeout_micros;
+  uint32_t generation;
+  {
+    ScopedLock L(&lock_);
+    if (cancel_requested_) cancelLocked();
+    if (cancelled_) return false;
+
+    generation = generation_;
+    calls_++;
+    if (calls_ == required_) {
+      calls_ = 0;
+      generation_++;
+      cv_.notifyAll();
+      return true;
+    }
+  }
+
+  // the other threads are often just about to arrive, avoid the cost of sleeping
+  for (uint32_t i = 0; i < spin_; i++) {
+    if (generation_ != generation) return true;
+    if (cancelled_ || cancel_requested_) break;
+  }
+
   ScopedLock L(&lock_);
-  calls_++;
+  while (generation_ == generation && !cancelled_) {
+    if (cancel_requested_) {
+      cancelLocked();
+      break;
+    }
 
-  if (calls_ != required_) {
-    cv_.wait(&lock_);
-  } else {
-    calls_ = 0;
-    cv_.notifyAll();
+    uint64_t now = Timer::getTimeMicros();
+    if (timed && now >= deadline) {
+      calls_--;                               // withdraw our arrival
+      return false;
+    }
+
+    // a signal handler cannot notify us, wake up often enough to see its request
+    uint64_t timeout = kCancelPoll;
+    if (timed) timeout = std::min(timeout, deadline - now);
+    cv_.waitFor(&lock_, timeout);
   }
+  return generation_ != generation;
+}
+
+void Barrier::cancel()
+{
+  ScopedLock L(&lock_);
+  cancelLocked();
+}
+
+void Barrier::requestCancel()
+{
+  cancel_requested_ = true;
+}
+
+void Barrier::cancelLocked()
+{
+  cancelled_ = true;
+  calls_     = 0;
+  cv_.notifyAll();
+}
+
+bool Barrier::isCancelled()
+{
+  return cancelled_ || cancel_requested_;
+}
+
+uint32_t Barrier::getGeneration()
+{
+  return generation_;
 }
 
 }}}   // namespace hyped::utils::concurrent
@@ -21,6 +21,7 @@
 #ifndef UTILS_CONCURRENT_BARRIER_HPP_
 #define UTILS_CONCURRENT_BARRIER_HPP_
 
+#include <atomic>
 #include <cstdint>
 
 #include "utils/concurrent/lock.hpp"
@@ -30,16 +31,69 @@ namespace hyped {
 namespace utils {
 namespace concurrent {
 
+/**
+ * Reusable barrier. Every time the required number of threads arrive, the barrier trips,
+ * releases all of them and starts a new generation. A thread that gives up waiting (timeout)
+ * withdraws its arrival so the barrier stays consistent for the remaining threads.
+ * Once cancelled, all waiting threads are released and every future wait fails immediately,
+ * this is used on shutdown so that a terminated module cannot deadlock the others.
+ */
 class Barrier {
  public:
-  explicit Barrier(uint8_t required);
+  /**
+   * @param required - number of threads that have to arrive before the barrier trips
+   * @param spin     - number of iterations to busy-wait for the barrier to trip before
+   *                   blocking the calling thread, 0 disables spinning
+   */
+  explicit Barrier(uint8_t required, uint32_t spin = 0);
   ~Barrier();
 
-  void wait();
+  /**
+   * @brief  Block until all required threads arrive or the barrier is cancelled.
+   *
+   * @return true iff the barrier tripped, false if it has been cancelled
+   */
+  bool wait();
+
+  /**
+   * @brief  Block until all required threads arrive, the barrier is cancelled or
+   *         the timeout expires.
+   *
+   * @param  timeout_micros - maximum time to wait for in microseconds
+   * @return true iff the barrier tripped
+   */
+  bool waitFor(uint64_t timeout_micros);
+
+  /**
+   * @brief Release all waiting threads, any future calls to wait() return false immediately.
+   */
+  void cancel();
+
+  /**
+   * @brief As cancel() but safe to call from a signal handler, it only marks the barrier.
+   *        Waiting threads notice within kCancelPoll and cancel it from their own context.
+   */
+  void requestCancel();
+
+  bool isCancelled();
+
+  /**
+   * @return number of times the barrier has tripped so far
+   */
+  uint32_t getGeneration();
 
  private:
+  static constexpr uint64_t kCancelPoll = 100000;   // microseconds
+
+  bool await(bool timed, uint64_t timeout_micros);
+  void cancelLocked();
+
   uint8_t required_;
   uint8_t calls_;
+  uint32_t spin_;
+  std::atomic<uint32_t> generation_;
+  std::atomic<bool>     cancelled_;
+  std::atomic<bool>     cancel_requested_;
 
   Lock    lock_;
   ConditionVariable cv_;
@@ -20,6 +20,9 @@
 
 #include "utils/concurrent/condition_variable.hpp"
 
+#include <chrono>
+
+#include "utils/clock.hpp"
 #include "utils/concurrent/lock.hpp"
 
 namespace hyped {
@@ -39,16 +42,34 @@ ConditionVariable::~ConditionVariable()
 void ConditionVariable::notify()
 {
   cond_var_->notify_one();
+  // in a simulation every waiter wakes, which is a spurious wakeup to all but one
+  SimulationClock* clock = SimulationClock::getInstalled();
+  if (clock) clock->notify(this);
 }
 
 void ConditionVariable::notifyAll()
 {
   cond_var_->notify_all();
+  SimulationClock* clock = SimulationClock::getInstalled();
+  if (clock) clock->notify(this);
 }
 
 void ConditionVariable::wait(Lock* lock)
 {
-  cond_var_->wait(*lock->mutex_);
+  waitFor(lock, SimulationClock::kForever);
+}
+
+bool ConditionVariable::waitFor(Lock* lock, uint64_t timeout_micros)
+{
+  // the clock registers the wait before it releases the lock, so no notification is missed
+  SimulationClock* clock = SimulationClock::getInstalled();
+  if (clock && clock->isAttached()) return clock->wait(this, timeout_micros, lock);
+  if (timeout_micros == SimulationClock::kForever) {
+    cond_var_->wait(*lock->mutex_);
+    return true;
+  }
+  return cond_var_->wait_for(*lock->mutex_, std::chrono::microseconds(timeout_micros))
+      == std::cv_status::no_timeout;
 }
 
 }}}   // hyped::utils::concurrent
@@ -24,6 +24,7 @@
 #define CV  condition_variable_any
 
 #include <condition_variable>
+#include <cstdint>
 
 namespace hyped {
 namespace utils {
@@ -56,6 +57,16 @@ class ConditionVariable {
    */
   void wait(Lock* lock);
 
+  /**
+   * @brief      Same as wait() but gives up after the specified time.
+   *
+   * @param      lock            The lock associated with this CV, see wait().
+   * @param      timeout_micros  Maximum time to block for in microseconds.
+   *
+   * @return     False iff the timeout expired before this CV was notified.
+   */
+  bool waitFor(Lock* lock, uint64_t timeout_micros);
+
  private:
   std::CV* cond_var_;
 };
@@ -28,36 +28,35 @@ namespace hyped {
 namespace utils {
 namespace concurrent {
 
-namespace {
-
-void thread_entry_point(Thread* this_)
-{
-  this_->run();
-}
-
-}   // namespace ::
-
 Thread::Thread(Logger& log)
     : id_(-1),
       thread_(0),
+      clock_(nullptr),
+      finished_(false),
       log_(log)
 { /* EMPTY */ }
 
 Thread::Thread(uint8_t id)
     : id_(id),
       thread_(0),
+      clock_(nullptr),
+      finished_(false),
       log_(System::getLogger())
 { /* EMPTY */ }
 
 Thread::Thread()
     : id_(-1),
       thread_(0),
+      clock_(nullptr),
+      finished_(false),
       log_(System::getLogger())
 { /* EMPTY */ }
 
 Thread::Thread(uint8_t id, Logger& log)
     : id_(id),
       thread_(0),
+      clock_(nullptr),
+      finished_(false),
       log_(log)
 { /* EMPTY */ }
 
@@ -65,14 +64,33 @@ Thread::~Thread() { /* EMPTY */ }
 
 void Thread::start()
 {
-  thread_ = new std::thread(thread_entry_point, this);
+  // the place in the schedule is taken before the thread exists, so its first turn is certain
+  clock_    = SimulationClock::getInstalled();
+  finished_ = false;
+  SimulationClock::Participant* participant = clock_ ? clock_->reserve() : nullptr;
+  thread_   = new std::thread(&Thread::entry, this, participant);
 }
 
 void Thread::join()
 {
+  // an attached thread blocked outside of the clock would stop it
+  if (clock_ && clock_->isAttached()) {
+    while (!finished_) clock_->wait(this, SimulationClock::kForever);
+  }
   thread_->join();
 }
 
+void Thread::entry(SimulationClock::Participant* participant)
+{
+  if (clock_) clock_->attach(participant);
+  run();
+  finished_ = true;
+  if (clock_) {
+    clock_->notify(this);
+    clock_->detach();
+  }
+}
+
 void Thread::run()
 {
   log_.INFO("THREAD", "You are starting EMPTY thread. Terminating now.");
@@ -80,11 +98,21 @@ void Thread::run()
 
 void Thread::yield()
 {
+  SimulationClock* clock = SimulationClock::getInstalled();
+  if (clock && clock->isAttached()) {
+    clock->sleep(0);
+    return;
+  }
   std::this_thread::yield();
 }
 
 void Thread::sleep(uint32_t ms)
 {
+  SimulationClock* clock = SimulationClock::getInstalled();
+  if (clock && clock->isAttached()) {
+    clock->sleep(ms*1000ull);
+    return;
+  }
   std::this_thread::sleep_for(std::chrono::microseconds(ms*1000));
 }
 
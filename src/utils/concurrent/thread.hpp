@@ -21,8 +21,10 @@
 #ifndef UTILS_CONCURRENT_THREAD_HPP_
 #define UTILS_CONCURRENT_THREAD_HPP_
 
+#include <atomic>
 #include <cstdint>
 #include <thread>
+#include "utils/clock.hpp"
 #include "utils/logger.hpp"
 
 namespace hyped {
@@ -40,7 +42,8 @@ class Thread {
   virtual ~Thread();
 
   /**
-   * @brief      Spawn new thread and call Run() method
+   * @brief      Spawn new thread and call Run() method, attached to the installed SimulationClock
+   *             if there is one
    */
   void start();
 
@@ -54,15 +57,25 @@ class Thread {
    */
   virtual void run();
 
+  /**
+   * @brief      Lets other threads run, in a simulation one yield time passes
+   */
   static void yield();
 
   uint8_t getId() { return id_; }
 
+  /**
+   * @brief      Sleeps for ms, on the SimulationClock if the calling thread is attached to one
+   */
   static void sleep(uint32_t ms);
 
  private:
+  void entry(utils::SimulationClock::Participant* participant);
+
   uint8_t id_;
   std::thread* thread_;
+  utils::SimulationClock* clock_;
+  std::atomic<bool> finished_;
 
  protected:
   Logger& log_;
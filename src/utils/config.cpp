@@ -33,6 +33,8 @@ namespace utils {
 
 #define BUFFER_SIZE 250   // max length of a line in the confix file in characters
 
+constexpr size_t kMaxInterfaceName = 16;  // IFNAMSIZ, including the terminating null
+
 typedef void (Config::* Parser) (char* line);
 struct ModuleEntry {
   Submodule label;
@@ -200,6 +202,75 @@ void Config::parseMotorControl(char* line)
       motor_control.isFaulty = atoi(value);
     }
   }
+
+  if (strcmp(token, "SdoWindow") == 0) {
+    char* value = strtok(NULL, " ");
+    if (value) {
+      motor_control.sdo_window = atoi(value);
+    }
+  }
+
+  if (strcmp(token, "SdoTimeout") == 0) {
+    char* value = strtok(NULL, " ");
+    if (value) {
+      motor_control.sdo_timeout = atoi(value);
+    }
+  }
+
+  if (strcmp(token, "SdoRetries") == 0) {
+    char* value = strtok(NULL, " ");
+    if (value) {
+      motor_control.sdo_retries = atoi(value);
+    }
+  }
+
+  if (strcmp(token, "PdoPeriod") == 0) {
+    char* value = strtok(NULL, " ");
+    if (value) {
+      motor_control.pdo_period = atoi(value);
+    }
+  }
+
+  if (strcmp(token, "ControlPeriod") == 0) {
+    char* value = strtok(NULL, " ");
+    if (value) {
+      motor_control.control_period = atoi(value);
+    }
+  }
+
+  if (strcmp(token, "MessageFiles") == 0) {
+    char* value = strtok(NULL, " ");
+    if (value) {
+      motor_control.message_files = value;
+    }
+  }
+}
+
+void Config::parseCan(char* line)
+{
+  char* token = strtok(line, " ");
+  char* value = strtok(NULL, " ");
+  if (!token || !value) {
+    log_.ERR("CONFIG", "lines for Can submodule must have format \"devices interface\" "
+                       "or \"Bitrate value\"");
+    return;
+  }
+  if (strcmp(token, "Bitrate") == 0) {
+    can.bitrate = atoi(value);
+    return;
+  }
+  if (strlen(value) >= kMaxInterfaceName) {
+    log_.ERR("CONFIG", "CAN interface name \"%s\" is too long", value);
+    return;
+  }
+
+  if (strcmp(token, "Motors") == 0) {
+    can.motors = value;
+  } else if (strcmp(token, "Bms") == 0) {
+    can.bms = value;
+  } else {
+    log_.ERR("CONFIG", "unknown CAN device group \"%s\"", token);
+  }
 }
 
 // if there is no creator configured to an interface, we use this one to prevent calling
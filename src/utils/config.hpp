@@ -60,6 +60,7 @@ struct ModuleEntry;
   V(Embrakes)           \
   V(Sensors)            \
   V(MotorControl)       \
+  V(Can)                \
   V(InterfaceFactory)
 
 #define CREATE_ENUM(module) \
@@ -104,8 +105,23 @@ class Config {
 
   struct MotorControl {
     int isFaulty;
+    int sdo_window  = 1;        // SDO requests waiting for a response at the same time
+    int sdo_timeout = 70000;    // microseconds before an SDO request is sent again
+    int sdo_retries = 2;
+    int pdo_period  = 10;       // milliseconds between actual value PDOs, 0 polls them by SDO
+    int control_period = 5000;  // microseconds between control ticks while driving the motors
+    // development override, read the controller messages from this directory instead of
+    // the tables generated from data/in/controllerConfigFiles at build time
+    std::string message_files;
   } motor_control;
 
+  // CAN interface of each group of devices, each interface gets its own reader and TX queue
+  struct Can {
+    std::string motors = "can0";
+    std::string bms    = "can0";
+    int bitrate        = 1000000;   // bits per second, same on all buses
+  } can;
+
   struct InterfaceFactory {
   // Module used in this context refers to the namespace containing the interface.
 #define CREATOR_FUNCTION_POINTERS(module, interface) \
@@ -20,14 +20,16 @@
 
 #include "utils/io/can.hpp"
 
+#include <errno.h>
 #include <stdio.h>
 #include <unistd.h>
-
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <net/if.h>
 
 #if LINUX
 #include <linux/can.h>
+#include <linux/can/raw.h>
 #else
 #define CAN_MAX_DLEN 8
 
@@ -46,6 +48,11 @@ struct can_frame {
 #endif  // if LINUX
 
 #define CAN_RAW 1
+#define SOL_CAN_RAW 101
+#define CAN_RAW_FILTER 1
+#define CAN_RAW_ERR_FILTER 2
+#define CAN_ERR_FLAG 0x20000000U
+#define CAN_ERR_MASK 0x1FFFFFFFU
 #define CAN_MTU (sizeof(struct can_frame))
 struct sockaddr_can {
   uint16_t can_family;
@@ -55,44 +62,151 @@ struct sockaddr_can {
   } can_addr;
 };
 
+
+struct can_filter {
+  uint32_t can_id;
+  uint32_t can_mask;
+};
+
 #endif   // CAN
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "utils/config.hpp"
+#include "utils/io/can_recorder.hpp"
+#include "utils/io/can_stats.hpp"
+#include "utils/io/can_transmitter.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
 namespace hyped {
 namespace utils {
 namespace io {
 
-Can::Can()
-    : concurrent::Thread(0)
+constexpr size_t CanDispatcher::kMaxFilters;
+constexpr int Can::kReceiveBatch;
+constexpr int Can::kReceiveTimeout;
+
+namespace {
+
+// buses opened through Can::getInstance(), never freed, they live until exit
+concurrent::Lock& getRegistryLock()
+{
+  static concurrent::Lock lock;
+  return lock;
+}
+
+std::map<std::string, Can*>& getRegistry()
 {
+  static std::map<std::string, Can*> registry;
+  return registry;
+}
+
+}   // namespace
+
+Can& Can::getInstance(const char* interface)
+{
+  concurrent::ScopedLock L(&getRegistryLock());
+  Can*& bus = getRegistry()[interface];
+  if (!bus) {
+    bus = new Can(interface);
+    Config* config = System::getSystem().config;
+    if (config) bus->stats_->setBitrate(config->can.bitrate);
+  }
+  return *bus;
+}
+
+std::vector<Can*> Can::getInstances()
+{
+  concurrent::ScopedLock L(&getRegistryLock());
+  std::vector<Can*> buses;
+  for (auto& item : getRegistry()) {
+    buses.push_back(item.second);
+  }
+  return buses;
+}
+
+Can& Can::getMotorBus()
+{
+  return getInstance(System::getSystem().config->can.motors.c_str());
+}
+
+Can& Can::getBmsBus()
+{
+  return getInstance(System::getSystem().config->can.bms.c_str());
+}
+
+Can::Can(const char* interface)
+    : Can(-1)
+{
+  snprintf(interface_, sizeof(interface_), "%s", interface);
   if ((socket_ = socket(PF_CAN, SOCK_RAW, CAN_RAW)) < 0) {
-    log_.ERR("CAN", "Could not open can socket");
+    log_.ERR("CAN", "Could not open can socket for %s", interface);
     return;
   }
 
   sockaddr_can addr;
   addr.can_family   = AF_CAN;
-  addr.can_ifindex  = if_nametoindex("can0");   // ifr.ifr_ifindex;
+  addr.can_ifindex  = if_nametoindex(interface);   // ifr.ifr_ifindex;
 
   if (addr.can_ifindex == 0) {
-    log_.ERR("CAN", "Could not find can0 network interface");
+    log_.ERR("CAN", "Could not find %s network interface", interface);
     close(socket_);
     socket_ = -1;
     return;
   }
 
   if (bind(socket_, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
-    log_.ERR("CAN", "Could not bind can socket");
+    log_.ERR("CAN", "Could not bind can socket to %s", interface);
     close(socket_);
     socket_ = -1;
     return;
   }
+  is_can_ = true;
+  configureSocket();
+
+  log_.INFO("CAN", "socket on %s successfully created", interface);
+}
 
-  log_.INFO("CAN", "socket successfully created");     // TODO(Gregor): log this only if successful
+Can::Can(int socket)
+    : concurrent::Thread(0),
+      socket_(socket),
+      interface_ {},
+      is_can_(false),
+      running_(false),
+      transmitter_(new CanTransmitter([this](const can::Frame& frame) { return write(frame); },
+                                      log_)),
+      recorder_(nullptr),
+      own_recorder_(nullptr),
+      stats_(new CanStats())
+{
+  if (socket_ < 0) return;
+
+#if LINUX
+  int domain;
+  socklen_t length = sizeof(domain);
+  is_can_ = getsockopt(socket_, SOL_SOCKET, SO_DOMAIN, &domain, &length) == 0
+            && domain == AF_CAN;
+#endif
+  configureSocket();
 }
 
 Can::~Can()
 {
-  running_ = false;
+  if (running_) {
+    running_ = false;
+    join();                 // the reader notices within kReceiveTimeout
+  }
+  delete transmitter_;      // fails frames still queued
+  delete stats_;
+  if (socket_ >= 0) close(socket_);
+  socket_ = -1;
+  recorder_ = nullptr;
+  delete own_recorder_;
 }
 
 void Can::start()
@@ -100,21 +214,58 @@ void Can::start()
   if (running_) return;   // already started
 
   running_ = true;
+  const char* record_file = System::getSystem().can_record_file;
+  if (record_file[0] && socket_ >= 0) {
+    // can0 records to the given file, every other bus to <file>.<interface>
+    char path[sizeof(System::getSystem().can_record_file) + sizeof(interface_)];
+    if (interface_[0] && strcmp(interface_, "can0") != 0) {
+      snprintf(path, sizeof(path), "%s.%s", record_file, interface_);
+    } else {
+      snprintf(path, sizeof(path), "%s", record_file);
+    }
+    own_recorder_ = new CanRecorder(log_);
+    if (own_recorder_->open(path)) setRecorder(own_recorder_);
+  }
   concurrent::Thread::start();
+  if (socket_ >= 0) transmitter_->start();
 }
 
-int Can::send(const can::Frame& frame)
+void Can::setRecorder(CanRecorder* recorder)
+{
+  recorder_ = recorder;
+}
+
+int Can::send(const can::Frame& frame, can::TxCallback callback)
 {
   if (socket_ < 0) return 0;  // early exit if no can device present
 
-  can_frame can;
-  log_.DBG2("CAN", "trying to send something");
   // checks, id <= ID_MAX, len <= LEN_MAX
   if (frame.len > 8) {
     log_.ERR("CAN", "trying to send message of more than 8 bytes, bytes: %d", frame.len);
     return 0;
   }
 
+  if (!transmitter_->enqueue(frame, callback)) {
+    log_.ERR("CAN", "transmit queue full, dropping message with id %d", frame.id);
+    return 0;
+  }
+  log_.DBG2("CAN", "message with id %d queued, extended:%d", frame.id, frame.extended);
+  return 1;
+}
+
+can::TxStats Can::getTxStats()
+{
+  return transmitter_->getStats();
+}
+
+can::BusStats Can::getStats()
+{
+  return stats_->getSnapshot();
+}
+
+int Can::write(const can::Frame& frame)
+{
+  can_frame can;
   can.can_id  = frame.id;
   can.can_id |= frame.extended ? can::Frame::kExtendedMask : 0;  // add extended id flag
   can.can_dlc = frame.len;
@@ -122,66 +273,181 @@ int Can::send(const can::Frame& frame)
     can.data[i] = frame.data[i];
   }
 
-  {
-    concurrent::ScopedLock L(&socket_lock_);
-    if (write(socket_, &can, CAN_MTU) != CAN_MTU) {
-      log_.ERR("CAN", "cannot write to socket");
-      return 0;
-    }
+  ssize_t written = ::write(socket_, &can, CAN_MTU);
+  if (written != CAN_MTU) {
+    int error = written < 0 ? errno : EIO;
+    stats_->addTransmitError(frame);
+    return error;
+  }
+
+  uint64_t now = Timer::getTimeMicros();
+  stats_->addTransmitted(frame, now);
+  CanRecorder* recorder = recorder_;
+  if (recorder) {
+    can::Frame sent = frame;
+    sent.timestamp  = now;
+    recorder->record(sent, true);
   }
 
   log_.DBG1("CAN", "message with id %d sent, extended:%d",
       frame.id, frame.extended);
-  return 1;
+  return 0;
 }
 
-void Can::run()
+void Can::configureSocket()
 {
-  /* these settings are static and can be held out of the hot path */
-  can::Frame data;
+  timeval timeout = {0, kReceiveTimeout * 1000};
+  if (setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+    log_.ERR("CAN", "could not set receive timeout, stopping may block");
+  }
 
-  log_.INFO("CAN", "starting continuous reading");
-  while (running_ && socket_ >= 0) {
-    receive(&data);
-    processNewData(&data);
+#if LINUX
+  // error frames are only counted, see CanStats, they never reach a CanProccesor
+  can_err_mask_t error_mask = CAN_ERR_MASK;
+  socklen_t      mask_size  = sizeof(error_mask);
+  if (is_can_ && setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &error_mask, mask_size) < 0) {
+    log_.ERR("CAN", "could not enable error frames on %s", interface_);
   }
-  log_.INFO("CAN", "stopped continuous reading");
 
-  if (socket_ >= 0) close(socket_);
+  int enable = 1;
+  if (setsockopt(socket_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) == 0) return;
+  if (setsockopt(socket_, SOL_SOCKET, SO_TIMESTAMP, &enable, sizeof(enable)) == 0) return;
+#endif
+  log_.ERR("CAN", "kernel receive timestamps not available, stamping frames on read");
 }
 
-int Can::receive(can::Frame* frame)
+void Can::run()
 {
-  size_t nBytes;
-  can_frame raw_data;
+  can::Frame frames[kReceiveBatch];
 
-  nBytes = read(socket_, &raw_data, CAN_MTU);
-  if (nBytes != CAN_MTU) {
-    // perror("read");
-    log_.ERR("CAN", "cannot read from socket");
-    return 0;
+  log_.INFO("CAN", "starting continuous reading on %s", interface_);
+  while (running_ && socket_ >= 0) {
+    int received = receive(frames, kReceiveBatch);
+    if (received < 0) break;
+    CanRecorder* recorder = recorder_;
+    for (int i = 0; i < received; i++) {
+      if (recorder) recorder->record(frames[i], false);
+      stats_->addReceived(frames[i]);
+      processNewData(&frames[i]);
+    }
   }
+  log_.INFO("CAN", "stopped continuous reading on %s", interface_);
+}
+
+namespace {
 
+void toFrame(const can_frame& raw_data, can::Frame* frame)
+{
   frame->id       = raw_data.can_id & ~can::Frame::kExtendedMask;
   frame->extended = raw_data.can_id & can::Frame::kExtendedMask;
-  frame->len      = raw_data.can_dlc;
+  frame->len      = raw_data.can_dlc > CAN_MAX_DLEN ? CAN_MAX_DLEN : raw_data.can_dlc;
   for (int i = 0; i < frame->len; i++) {
     frame->data[i] = raw_data.data[i];
   }
+}
+
+#if LINUX
+/**
+ * @return kernel receive time of the message converted to Timer base, or fallback if the
+ * message carries no SCM_TIMESTAMPNS/SCM_TIMESTAMP control message
+ */
+uint64_t getTimestamp(msghdr* message, uint64_t fallback)
+{
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(message); cmsg; cmsg = CMSG_NXTHDR(message, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET) continue;
+    if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      timespec time;
+      memcpy(&time, CMSG_DATA(cmsg), sizeof(time));
+      return Timer::fromEpochMicros(static_cast<uint64_t>(time.tv_sec) * 1000000
+                                    + time.tv_nsec / 1000);
+    }
+    if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval time;
+      memcpy(&time, CMSG_DATA(cmsg), sizeof(time));
+      return Timer::fromEpochMicros(static_cast<uint64_t>(time.tv_sec) * 1000000
+                                    + time.tv_usec);
+    }
+  }
+  return fallback;
+}
+#endif
+
+}   // namespace
+
+int Can::receive(can::Frame* frames, int max)
+{
+  can_frame raw_data[kReceiveBatch];
+  if (max > kReceiveBatch) max = kReceiveBatch;
+
+#if LINUX
+  // large enough for either timestamp control message
+  static constexpr size_t kControlSize = CMSG_SPACE(sizeof(timespec));
+  iovec   iov[kReceiveBatch];
+  mmsghdr messages[kReceiveBatch];
+  alignas(cmsghdr) char control[kReceiveBatch][kControlSize];
+
+  memset(messages, 0, sizeof(messages));
+  for (int i = 0; i < max; i++) {
+    iov[i].iov_base                     = &raw_data[i];
+    iov[i].iov_len                      = CAN_MTU;
+    messages[i].msg_hdr.msg_iov         = &iov[i];
+    messages[i].msg_hdr.msg_iovlen      = 1;
+    messages[i].msg_hdr.msg_control     = control[i];
+    messages[i].msg_hdr.msg_controllen  = kControlSize;
+  }
+
+  // block for the first frame, then take whatever else is already queued
+  int received = recvmmsg(socket_, messages, max, MSG_WAITFORONE, nullptr);
+  if (received <= 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+      log_.ERR("CAN", "cannot read from socket");
+    }
+    return 0;
+  }
+
+  uint64_t now = Timer::getTimeMicros();
+  int count = 0;
+  // an empty datagram only arrives once the other end of a socketpair closed
+  if (messages[0].msg_len == 0) return -1;
+  for (int i = 0; i < received; i++) {
+    if (messages[i].msg_len != CAN_MTU) {
+      log_.ERR("CAN", "received incomplete frame of %u bytes", messages[i].msg_len);
+      continue;
+    }
+    if (raw_data[i].can_id & CAN_ERR_FLAG) {
+      stats_->addErrorFrame(raw_data[i].can_id & CAN_ERR_MASK);
+      log_.DBG("CAN", "error frame on %s, class 0x%x", interface_,
+          raw_data[i].can_id & CAN_ERR_MASK);
+      continue;
+    }
+    can::Frame* frame = &frames[count++];
+    toFrame(raw_data[i], frame);
+    frame->timestamp = getTimestamp(&messages[i].msg_hdr, now);
+    log_.DBG1("CAN", "received %u %u, extended %d",
+        raw_data[i].can_id, frame->id, frame->extended);
+  }
+  return count;
+#else
+  if (max < 1 || read(socket_, &raw_data[0], CAN_MTU) != CAN_MTU) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+      log_.ERR("CAN", "cannot read from socket");
+    }
+    return 0;
+  }
+  toFrame(raw_data[0], &frames[0]);
+  frames[0].timestamp = Timer::getTimeMicros();
   log_.DBG1("CAN", "received %u %u, extended %d",
-      raw_data.can_id, frame->id, frame->extended);
+      raw_data[0].can_id, frames[0].id, frames[0].extended);
   return 1;
+#endif
 }
 
 void Can::processNewData(can::Frame* message)
 {
-  CanProccesor* owner = 0;
-
-  for (CanProccesor* processor : processors_) {
-    if (processor->hasId(message->id, message->extended)) {
-      owner = processor;
-      break;
-    }
+  CanProccesor* owner;
+  {
+    concurrent::ScopedLock L(&dispatcher_lock_);
+    owner = dispatcher_.find(message->id, message->extended);
   }
 
   if (owner) {
@@ -193,7 +459,122 @@ void Can::processNewData(can::Frame* message)
 
 void Can::registerProcessor(CanProccesor* processor)
 {
-  processors_.push_back(processor);
+  concurrent::ScopedLock L(&dispatcher_lock_);
+  dispatcher_.add(processor);
+  updateFilters();
+}
+
+void Can::updateFilters()
+{
+  if (socket_ < 0 || !is_can_) return;
+
+  std::vector<can::Filter> filters;
+  std::vector<can_filter>  raw_filters;
+  if (dispatcher_.getFilters(&filters)) {
+    for (const can::Filter& filter : filters) {
+      raw_filters.push_back({filter.id, filter.mask});
+    }
+  } else {
+    raw_filters.push_back({0, 0});    // accept all
+  }
+
+  socklen_t size = raw_filters.size() * sizeof(can_filter);
+  if (setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FILTER, raw_filters.data(), size) < 0) {
+    log_.ERR("CAN", "could not install %zu receive filters", raw_filters.size());
+    return;
+  }
+  log_.DBG("CAN", "installed %zu receive filters", raw_filters.size());
+}
+
+void CanDispatcher::add(CanProccesor* processor)
+{
+  std::vector<can::IdRange> declared;
+  processor->getIdRanges(&declared);
+  if (declared.empty()) {
+    undeclared_.push_back(processor);
+    return;
+  }
+
+  declared_.insert(declared_.end(), declared.begin(), declared.end());
+  for (const can::IdRange& range : declared) {
+    if (range.last - range.first < kMaxExpandedRange) {
+      for (uint32_t id = range.first; id <= range.last; id++) {
+        ids_.emplace(makeKey(id, range.extended), processor);   // keeps earlier owner
+      }
+    } else {
+      RangeEntry entry = {makeKey(range.first, range.extended),
+                          makeKey(range.last, range.extended),
+                          processor};
+      auto position = std::upper_bound(ranges_.begin(), ranges_.end(), entry,
+          [](const RangeEntry& a, const RangeEntry& b) { return a.first < b.first; });
+      ranges_.insert(position, entry);
+    }
+  }
+}
+
+CanProccesor* CanDispatcher::find(uint32_t id, bool extended) const
+{
+  uint32_t key = makeKey(id, extended);
+
+  auto it = ids_.find(key);
+  if (it != ids_.end()) return it->second;
+
+  if (!ranges_.empty()) {
+    // last range starting at or before key
+    auto range = std::upper_bound(ranges_.begin(), ranges_.end(), key,
+        [](uint32_t k, const RangeEntry& entry) { return k < entry.first; });
+    if (range != ranges_.begin() && key <= (--range)->last) return range->processor;
+  }
+
+  for (CanProccesor* processor : undeclared_) {
+    if (processor->hasId(id, extended)) return processor;
+  }
+  return nullptr;
+}
+
+bool CanDispatcher::getFilters(std::vector<can::Filter>* filters) const
+{
+  filters->clear();
+  if (!undeclared_.empty()) return false;
+
+  std::vector<can::IdRange> merged = declared_;
+  std::sort(merged.begin(), merged.end(),
+      [](const can::IdRange& a, const can::IdRange& b)
+      { return makeKey(a.first, a.extended) < makeKey(b.first, b.extended); });
+  size_t count = 0;
+  for (const can::IdRange& range : merged) {
+    if (count > 0) {
+      can::IdRange& previous = merged[count - 1];
+      if (previous.extended == range.extended && range.first <= uint64_t(previous.last) + 1) {
+        previous.last = std::max(previous.last, range.last);
+        continue;
+      }
+    }
+    merged[count++] = range;
+  }
+  merged.resize(count);
+
+  for (const can::IdRange& range : merged) {
+    uint32_t id_mask = range.extended ? can::Filter::kExtendedIdMask
+                                      : can::Filter::kStandardIdMask;
+    uint32_t flag    = range.extended ? can::Frame::kExtendedMask : 0;
+    uint64_t start   = range.first;
+    uint64_t end     = uint64_t(range.last) + 1;
+    while (start < end) {
+      // largest block aligned at start that does not overshoot the range
+      uint64_t size = start ? (start & (~start + 1)) : uint64_t(id_mask) + 1;
+      while (start + size > end) size >>= 1;
+      uint32_t mask = ~static_cast<uint32_t>(size - 1) & id_mask;
+      filters->push_back({static_cast<uint32_t>(start) | flag, mask | can::Frame::kExtendedMask});
+      start += size;
+    }
+  }
+
+  if (filters->size() > kMaxFilters) {
+    filters->clear();
+    return false;
+  }
+  return true;
 }
 
 }}}   // namespace hyped::utils::io
@@ -7,7 +7,8 @@
  * CAN_FD is not supported.
  *
  * To the rest of the system CAN messages are described as can::Frame structure.
- * Sending messages is performed directly in the caller's thread.
+ * Sending messages only enqueues them, a dedicated CanTransmitter thread writes them to the
+ * socket in bus priority order.
  * Receiving messages is performed using a dedicated thread. This thread awaits
  * incoming messages and demultiplexes them to matching registered BMS/Motors units.
  *
@@ -28,7 +29,10 @@
 #ifndef UTILS_IO_CAN_HPP_
 #define UTILS_IO_CAN_HPP_
 
+#include <atomic>
 #include <cstdint>
+#include <unordered_map>
+#include <functional>
 #include <vector>
 
 #include "utils/concurrent/lock.hpp"
@@ -47,10 +51,81 @@ struct Frame {
   bool      extended;
   uint8_t   len;
   uint8_t   data[8];
+  uint64_t  timestamp;    // arrival time in Timer::getTimeMicros() base, set on receive only
+};
+
+/**
+ * Inclusive range of CAN ids, used by CanProccesor to declare which messages it owns.
+ */
+struct IdRange {
+  uint32_t  first;
+  uint32_t  last;
+  bool      extended;
+};
+
+/**
+ * Kernel side acceptance filter, a frame passes iff (frame id & mask) == (id & mask).
+ * Both fields carry the extended flag (can::Frame::kExtendedMask) the same way SocketCAN
+ * encodes it in can_filter.
+ */
+struct Filter {
+  static constexpr uint32_t kStandardIdMask = 0x000007FFU;
+  static constexpr uint32_t kExtendedIdMask = 0x1FFFFFFFU;
+  uint32_t  id;
+  uint32_t  mask;
+};
+
+/**
+ * Writes one frame to the bus, returns 0 on success or the errno of the failed write
+ */
+typedef std::function<int(const Frame& frame)> Writer;    // NOLINT [readability/casting]
+
+/**
+ * Called by the transmit thread once a frame has been written to the socket (sent = true)
+ * or has been given up on (sent = false).
+ */
+typedef std::function<void(const Frame& frame, bool sent)> TxCallback;
+
+struct TxStats {
+  uint32_t  queue_depth;        // frames currently waiting
+  uint32_t  max_queue_depth;
+  uint64_t  sent;
+  uint64_t  failed;             // write error or retries exhausted
+  uint64_t  rejected;           // queue full on send
+  uint64_t  retries;            // writes repeated after ENOBUFS/EAGAIN
+  uint64_t  last_latency;       // microseconds from enqueue to completed write
+  uint64_t  max_latency;
+  double    mean_latency;
+};
+
+struct IdStats {
+  uint32_t  id;
+  bool      extended;
+  uint64_t  rx_frames;
+  uint64_t  tx_frames;
+  uint64_t  tx_errors;          // failed writes, including ones retried later
+  uint64_t  last_seen;          // Timer::getTimeMicros() of the last frame in either direction
+  double    mean_interval;      // microseconds between received frames
+  double    jitter;             // standard deviation of the receive interval
+};
+
+struct BusStats {
+  uint64_t  rx_frames;
+  uint64_t  tx_frames;
+  uint64_t  error_frames;       // reported by the CAN controller, e.g. bus errors or bus off
+  uint32_t  last_error_class;   // CAN_ERR_* bits of the latest error frame
+  uint64_t  bits;               // on the wire, stuff bits and interframe space included
+  uint32_t  bitrate;
+  double    utilisation;        // fraction of the bitrate used over the latest window
+  std::vector<IdStats> ids;     // ordered by extended flag, then id
 };
 
 }   // namespace can
 
+class CanTransmitter;
+class CanRecorder;
+class CanStats;
+
 class CanProccesor {
  public:
  /**
@@ -69,30 +144,154 @@ class CanProccesor {
    * @return true     - iff this CanProcessor owns the corresponding message
    */
   virtual bool hasId(uint32_t id, bool extended) = 0;
+
+  /**
+   * @brief To be called by CAN once upon registration to build the id lookup table.
+   * Processors that do not declare any ids are asked via hasId() about every frame
+   * no declared owner was found for.
+   *
+   * @param ranges - output, all id ranges owned by this CanProcessor are appended to it
+   */
+  virtual void getIdRanges(std::vector<can::IdRange>* ranges) { /* EMPTY */ }
+};
+
+/**
+ * Resolves the owner of a received can::Frame. Ids declared through
+ * CanProccesor::getIdRanges() are found in constant time using a hash table, wide ranges are
+ * kept in a table sorted by first id and binary searched. If several processors claim the same
+ * id, the one registered first owns it.
+ */
+class CanDispatcher {
+ public:
+  void add(CanProccesor* processor);
+
+  /**
+   * @return owner of the message or nullptr if no registered processor owns it
+   */
+  CanProccesor* find(uint32_t id, bool extended) const;
+
+  /**
+   * @brief Build acceptance filters passing exactly the declared ids. Adjacent ids are merged
+   * and every range is split into aligned power-of-two blocks, each matched by one id/mask pair.
+   *
+   * @param filters - output, cleared and filled with the filters
+   * @return false  - iff frames cannot be filtered, i.e. a processor relies on hasId()
+   *                  or more than kMaxFilters filters would be needed
+   */
+  bool getFilters(std::vector<can::Filter>* filters) const;
+
+  // SocketCAN limit on number of filters per socket (CAN_RAW_FILTER_MAX)
+  static constexpr size_t kMaxFilters = 512;
+
+ private:
+  // ranges spanning more ids than this are not expanded into the hash table
+  static constexpr uint32_t kMaxExpandedRange = 64;
+
+  struct RangeEntry {
+    uint32_t      first;    // lookup keys, see makeKey()
+    uint32_t      last;
+    CanProccesor* processor;
+  };
+
+  static uint32_t makeKey(uint32_t id, bool extended)
+  {
+    return id | (extended ? can::Frame::kExtendedMask : 0);
+  }
+
+  std::unordered_map<uint32_t, CanProccesor*> ids_;
+  std::vector<RangeEntry>                     ranges_;      // sorted by first
+  std::vector<can::IdRange>                   declared_;    // everything declared, for filters
+  std::vector<CanProccesor*>                  undeclared_;  // processors relying on hasId()
 };
 
 /**
- * Can implements singleton pattern to encapsulate one can interface, namely can0.
+ * Can encapsulates one can interface. Every interface in use, e.g. can0, can1 or vcan0, has
+ * its own instance with an independent reading thread and transmit queue, obtained through
+ * getInstance(interface). Which devices talk on which interface is set in the Can section of
+ * the configuration, so high rate motor traffic can be kept away from the BMS units.
  * During object construction, can intereface is mapped onto socket_ member variable.
- * Furthermore, constructor spawns reading thread which waits on incoming can messages.
+ * Furthermore, start() spawns reading thread which waits on incoming can messages.
  * These messages are put into one of consuming queues based on configured id spaces.
  * The reading itself is performed in overriden run() method.
  */
 class Can : public concurrent::Thread {
  public:
-  static Can& getInstance()
-  {
-    static Can can;
-    return can;
-  }
+  /**
+   * @brief The pod's bus, can0
+   */
+  static Can& getInstance() { return getInstance("can0"); }
+
+  /**
+   * @brief Bus on the named interface, opened on first use and kept for the rest of the run
+   */
+  static Can& getInstance(const char* interface);
+
+  /**
+   * @return all buses opened through getInstance() so far, ordered by interface name
+   */
+  static std::vector<Can*> getInstances();
+
+  /**
+   * @brief Buses the motor controllers and the BMS units are on, see Config::Can
+   */
+  static Can& getMotorBus();
+  static Can& getBmsBus();
+
+  /**
+   * @brief Open a raw CAN socket bound to the named interface
+   */
+  explicit Can(const char* interface);
+
+  /**
+   * @brief Take ownership of an already open socket exchanging struct can_frame sized
+   * datagrams, e.g. one end of a socketpair standing in for a CAN interface in tests.
+   * Kernel filters are only installed if it is a CAN socket.
+   */
+  explicit Can(int socket);
+
+  /**
+   * @brief Stops the receive and transmit threads and closes the socket. Registered processors
+   * are not notified, they must not be destroyed before Can.
+   */
+  ~Can();
 
   NO_COPY_ASSIGN(Can);
 
   /**
-   * @param  frame data to be sent
-   * @return 1     iff data sent successfully
+   * @return true iff the socket is open, i.e. frames can be sent and received
    */
-  int send(const can::Frame& frame);
+  bool isOpen() const { return socket_ >= 0; }
+
+  /**
+   * @return name of the bound interface, empty for adopted sockets
+   */
+  const char* getInterface() const { return interface_; }
+
+  /**
+   * @brief Queue frame for transmission, never blocks on the socket
+   *
+   * @param  frame    data to be sent
+   * @param  callback optional, notified from the transmit thread once the frame is done
+   * @return 1        iff data queued successfully
+   */
+  int send(const can::Frame& frame, can::TxCallback callback = nullptr);
+
+  /**
+   * @return snapshot of transmit queue statistics
+   */
+  can::TxStats getTxStats();
+
+  /**
+   * @return snapshot of per-id counters, error frames and bus utilisation
+   */
+  can::BusStats getStats();
+
+  /**
+   * @brief Record all received and sent frames from now on, nullptr stops recording.
+   * Started automatically by start() if --can_record=<file> is given.
+   * The recorder must outlive Can or be unset before it is destroyed.
+   */
+  void setRecorder(CanRecorder* recorder);
 
   /**
    * @brief Called by any Can-enabled device implementing CanProcessor interface
@@ -100,16 +299,34 @@ class Can : public concurrent::Thread {
   void registerProcessor(CanProccesor* processor);
 
   /**
-   * @brief To be called for starting the receive thread
+   * @brief To be called for starting the receive and transmit threads
    */
   void start();
 
  private:
   /**
-   * @param  frame output pointer to data to be filled
-   * @return 1     iff data received successfully
+   * @brief Write one frame to the socket, called by the transmit thread only
+   *
+   * @return 0 iff written, errno otherwise
    */
-  int receive(can::Frame* frame);
+  int write(const can::Frame& frame);
+
+  // maximum number of frames drained from the socket by one receive() call
+  static constexpr int kReceiveBatch = 32;
+
+  // longest time receive() blocks, bounds how long stopping the receive thread takes
+  static constexpr int kReceiveTimeout = 100;   // milliseconds
+
+  /**
+   * @brief Block until at least one frame arrives, then read all frames that are already
+   * queued (up to max) with a single syscall. Frames are stamped with their kernel receive time.
+   *
+   * @param  frames output array of at least max frames to be filled
+   * @param  max    maximum number of frames to receive
+   * @return number of frames received, 0 on error, -1 if the other end of an adopted socket
+   * has been closed
+   */
+  int receive(can::Frame* frames, int max);
 
   /**
    * @brief Process received message. Check whom does it belong to.
@@ -119,19 +336,35 @@ class Can : public concurrent::Thread {
    */
   void processNewData(can::Frame* frame);
 
+  /**
+   * @brief Install kernel side filters so the socket only receives frames some registered
+   * processor owns. Falls back to receiving everything if the ids cannot be expressed
+   * as filters. Has to be called with dispatcher_lock_ held.
+   */
+  void updateFilters();
+
+  /**
+   * @brief Enable kernel receive timestamps, nanosecond resolution if available,
+   * and bound blocking reads by kReceiveTimeout
+   */
+  void configureSocket();
+
   /**
    * Blocking read and demultiplex messages based on configured id spaces
    */
   void run() override;
 
-  Can();
-  ~Can();
-
  private:
-  int   socket_;
-  bool  running_;
-  std::vector<CanProccesor*>  processors_;
-  concurrent::Lock            socket_lock_;
+  int                         socket_;
+  char                        interface_[16];   // IFNAMSIZ
+  bool                        is_can_;      // false for stand-in sockets, see Can(int)
+  std::atomic<bool>           running_;
+  CanTransmitter*             transmitter_;
+  std::atomic<CanRecorder*>   recorder_;
+  CanRecorder*                own_recorder_;      // created from --can_record
+  CanStats*                   stats_;
+  CanDispatcher               dispatcher_;
+  concurrent::Lock            dispatcher_lock_;
 };
 
 }}}   // namespace hyped::utils::io
@@ -0,0 +1,217 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Binary CAN traffic recording, candump export and timed replay
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "utils/io/can_recorder.hpp"
+
+#include <errno.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <vector>
+
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+static_assert(sizeof(can::Record) == 24, "CAN record layout changed, bump kVersion");
+
+constexpr uint32_t can::RecordHeader::kMagic;
+constexpr uint32_t can::RecordHeader::kVersion;
+constexpr uint8_t  can::Record::kTransmitted;
+constexpr uint8_t  can::Record::kExtended;
+
+CanRecorder::CanRecorder(Logger& log)
+    : log_(log),
+      file_(nullptr),
+      count_(0)
+{ /* EMPTY */ }
+
+CanRecorder::~CanRecorder()
+{
+  close();
+}
+
+bool CanRecorder::open(const char* path)
+{
+  concurrent::ScopedLock L(&lock_);
+  if (file_) fclose(file_);
+  count_ = 0;
+
+  file_ = fopen(path, "wb");
+  if (!file_) {
+    log_.ERR("CAN", "could not open CAN recording %s: %s", path, strerror(errno));
+    return false;
+  }
+
+  can::RecordHeader header = {can::RecordHeader::kMagic, can::RecordHeader::kVersion,
+                              Timer::toEpochMicros(0)};
+  if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+    log_.ERR("CAN", "could not write CAN recording header to %s", path);
+    fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+  log_.INFO("CAN", "recording CAN traffic to %s", path);
+  return true;
+}
+
+void CanRecorder::close()
+{
+  concurrent::ScopedLock L(&lock_);
+  if (!file_) return;
+  fclose(file_);
+  file_ = nullptr;
+  log_.INFO("CAN", "CAN recording closed, %u frames", static_cast<uint32_t>(count_));
+}
+
+void CanRecorder::record(const can::Frame& frame, bool transmitted)
+{
+  can::Record record = {};
+  record.timestamp  = frame.timestamp;
+  record.id         = frame.id;
+  record.flags      = (transmitted ? can::Record::kTransmitted : 0)
+                    | (frame.extended ? can::Record::kExtended : 0);
+  record.len        = frame.len;
+  memcpy(record.data, frame.data, sizeof(record.data));
+
+  concurrent::ScopedLock L(&lock_);
+  if (!file_) return;
+  if (fwrite(&record, sizeof(record), 1, file_) == 1) count_++;
+}
+
+uint64_t CanRecorder::getCount()
+{
+  concurrent::ScopedLock L(&lock_);
+  return count_;
+}
+
+bool CanRecorder::read(const char* path, std::vector<can::Record>* records,
+                       uint64_t* epoch_offset)
+{
+  FILE* file = fopen(path, "rb");
+  if (!file) return false;
+
+  can::RecordHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1
+      || header.magic != can::RecordHeader::kMagic
+      || header.version != can::RecordHeader::kVersion) {
+    fclose(file);
+    return false;
+  }
+  if (epoch_offset) *epoch_offset = header.epoch_offset;
+
+  records->clear();
+  can::Record record;
+  while (fread(&record, sizeof(record), 1, file) == 1) {
+    records->push_back(record);
+  }
+  fclose(file);
+  return true;
+}
+
+void CanRecorder::formatCandump(const can::Record& record, uint64_t epoch_offset,
+                                const char* interface, char* line, size_t size)
+{
+  uint64_t time = record.timestamp + epoch_offset;
+  int written = snprintf(line, size, "(%lu.%06lu) %s %0*X#",
+      static_cast<unsigned long>(time / 1000000),        // NOLINT [runtime/int]
+      static_cast<unsigned long>(time % 1000000),        // NOLINT [runtime/int]
+      interface, (record.flags & can::Record::kExtended) ? 8 : 3, record.id);
+  for (int i = 0; i < record.len && i < 8 && written > 0 && size_t(written) < size; i++) {
+    written += snprintf(line + written, size - written, "%02X", record.data[i]);
+  }
+}
+
+bool CanRecorder::exportCandump(const char* path, const char* out_path, const char* interface)
+{
+  std::vector<can::Record> records;
+  uint64_t epoch_offset;
+  if (!read(path, &records, &epoch_offset)) return false;
+
+  FILE* out = fopen(out_path, "w");
+  if (!out) return false;
+  char line[128];
+  for (const can::Record& record : records) {
+    formatCandump(record, epoch_offset, interface, line, sizeof(line));
+    fprintf(out, "%s\n", line);
+  }
+  fclose(out);
+  return true;
+}
+
+CanReplayer::CanReplayer(Writer writer, Logger& log)
+    : writer_(writer),
+      log_(log),
+      max_lag_(0)
+{ /* EMPTY */ }
+
+uint64_t CanReplayer::replay(const std::vector<can::Record>& records, double speed,
+                             bool include_transmit)
+{
+  // give the interface queue some time to drain if it is full
+  constexpr int kMaxAttempts = 100;
+  constexpr int kRetryDelay  = 100;   // microseconds
+
+  max_lag_ = 0;
+  uint64_t written     = 0;
+  uint64_t first_time  = 0;
+  uint64_t start       = Timer::getTimeMicros();
+  bool     first       = true;
+
+  for (const can::Record& record : records) {
+    if ((record.flags & can::Record::kTransmitted) && !include_transmit) continue;
+
+    if (first) {
+      first_time = record.timestamp;
+      first      = false;
+    }
+    if (speed > 0) {
+      // receive and transmit timestamps come from different clocks, keep the file order
+      uint64_t offset = record.timestamp > first_time ? record.timestamp - first_time : 0;
+      uint64_t due    = start + static_cast<uint64_t>(offset / speed);
+      uint64_t now = Timer::getTimeMicros();
+      if (now < due) {
+        usleep(due - now);
+        now = Timer::getTimeMicros();
+      }
+      if (now > due && now - due > max_lag_) max_lag_ = now - due;
+    }
+
+    can::Frame frame = {};
+    frame.id        = record.id;
+    frame.extended  = record.flags & can::Record::kExtended;
+    frame.len       = record.len;
+    frame.timestamp = record.timestamp;
+    memcpy(frame.data, record.data, sizeof(frame.data));
+
+    int error = writer_(frame);
+    for (int i = 1; i < kMaxAttempts && (error == ENOBUFS || error == EAGAIN); i++) {
+      usleep(kRetryDelay);
+      error = writer_(frame);
+    }
+    if (error) {
+      log_.ERR("CAN", "replay could not write frame with id %u: %s", record.id, strerror(error));
+      continue;
+    }
+    written++;
+  }
+  return written;
+}
+
+}}}   // namespace hyped::utils::io
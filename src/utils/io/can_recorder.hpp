@@ -0,0 +1,148 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * CanRecorder captures every frame received and sent by utils::io::Can into a compact binary
+ * file, enabled with --can_record=<file>. CanReplayer writes recorded frames back onto a bus,
+ * e.g. vcan0, keeping the original timing, scaled timing or as fast as possible.
+ *
+ * File layout (host byte order): one can::RecordHeader followed by can::Record entries of
+ * 24 bytes each. Record timestamps use the Timer::getTimeMicros() base of the recording process,
+ * the header stores its Unix epoch offset so files can be exported with absolute time in
+ * candump log format: (1602518400.000123) can0 581#4B40600000000000
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef UTILS_IO_CAN_RECORDER_HPP_
+#define UTILS_IO_CAN_RECORDER_HPP_
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "utils/concurrent/lock.hpp"
+#include "utils/io/can.hpp"
+#include "utils/logger.hpp"
+#include "utils/utils.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+namespace can {
+
+struct RecordHeader {
+  static constexpr uint32_t kMagic   = 0x4E414348;   // "HCAN"
+  static constexpr uint32_t kVersion = 1;
+  uint32_t  magic;
+  uint32_t  version;
+  uint64_t  epoch_offset;   // Unix epoch micros of timestamp 0
+};
+
+struct Record {
+  static constexpr uint8_t kTransmitted = 0x01;   // sent by us, otherwise received
+  static constexpr uint8_t kExtended    = 0x02;
+  uint64_t  timestamp;
+  uint32_t  id;
+  uint8_t   flags;
+  uint8_t   len;
+  uint8_t   data[8];
+  uint8_t   reserved[2];
+};
+
+}   // namespace can
+
+class CanRecorder {
+ public:
+  explicit CanRecorder(Logger& log);
+  ~CanRecorder();
+  NO_COPY_ASSIGN(CanRecorder);
+
+  /**
+   * @brief Create or truncate the file and write the header
+   * @return true iff the file is ready for recording
+   */
+  bool open(const char* path);
+  void close();
+
+  /**
+   * @brief Append frame to the file, safe to call from the receive and transmit threads
+   *
+   * @param frame       - frame including its timestamp
+   * @param transmitted - true if the frame was sent by us
+   */
+  void record(const can::Frame& frame, bool transmitted);
+
+  uint64_t getCount();
+
+  /**
+   * @brief Load a recording
+   *
+   * @param epoch_offset - output, optional, Unix epoch micros of timestamp 0
+   * @return false iff the file cannot be read or is not a recording
+   */
+  static bool read(const char* path, std::vector<can::Record>* records,
+                   uint64_t* epoch_offset = nullptr);
+
+  /**
+   * @brief Format one record as a candump log line, without trailing newline
+   */
+  static void formatCandump(const can::Record& record, uint64_t epoch_offset,
+                            const char* interface, char* line, size_t size);
+
+  /**
+   * @brief Convert a recording into a candump log file which can-utils (canplayer, log2asc)
+   * understand. Direction is not part of the candump format, so received and transmitted
+   * frames are exported alike.
+   */
+  static bool exportCandump(const char* path, const char* out_path, const char* interface);
+
+ private:
+  Logger&           log_;
+  FILE*             file_;
+  uint64_t          count_;
+  concurrent::Lock  lock_;
+};
+
+class CanReplayer {
+ public:
+  typedef can::Writer Writer;
+
+  CanReplayer(Writer writer, Logger& log);
+
+  /**
+   * @brief Write recorded frames keeping their relative timing, blocks until done
+   *
+   * @param records           - recording to replay
+   * @param speed             - 1 for original timing, 2 for twice as fast, 0 for maximum speed
+   * @param include_transmit  - also replay frames the recording process sent itself
+   * @return number of frames written
+   */
+  uint64_t replay(const std::vector<can::Record>& records, double speed,
+                  bool include_transmit = false);
+
+  /**
+   * @return largest delay in microseconds between the scheduled and actual write of a frame
+   * during the last replay
+   */
+  uint64_t getMaxLag() const { return max_lag_; }
+
+ private:
+  Writer    writer_;
+  Logger&   log_;
+  uint64_t  max_lag_;
+};
+
+}}}   // namespace hyped::utils::io
+
+#endif  // UTILS_IO_CAN_RECORDER_HPP_
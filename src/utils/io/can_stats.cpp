@@ -0,0 +1,221 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Per-id CAN statistics and bus utilisation from bit-stuffed frame lengths
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "utils/io/can_stats.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+constexpr uint32_t CanStats::kDefaultBitrate;
+constexpr uint64_t CanStats::kWindow;
+
+namespace {
+
+// CRC delimiter, ACK slot, ACK delimiter, end of frame and interframe space, never stuffed
+constexpr uint32_t kTrailerBits = 1 + 1 + 1 + 7 + 3;
+constexpr uint16_t kCrcPolynomial = 0x4599;   // CRC-15/CAN
+
+/**
+ * @brief Append the lowest count bits of value, most significant first
+ */
+void pushBits(uint8_t* bits, int* n, uint32_t value, int count)
+{
+  for (int i = count - 1; i >= 0; i--) {
+    bits[(*n)++] = (value >> i) & 1;
+  }
+}
+
+bool byKey(const can::IdStats& a, const can::IdStats& b)
+{
+  if (a.extended != b.extended) return !a.extended;
+  return a.id < b.id;
+}
+
+}   // namespace
+
+CanStats::CanStats(uint32_t bitrate)
+    : rx_frames_(0),
+      tx_frames_(0),
+      error_frames_(0),
+      last_error_class_(0),
+      bits_(0),
+      bitrate_(bitrate),
+      window_start_(0),
+      window_bits_(0),
+      utilisation_(0)
+{ /* EMPTY */ }
+
+void CanStats::setBitrate(uint32_t bitrate)
+{
+  concurrent::ScopedLock L(&lock_);
+  bitrate_ = bitrate;
+}
+
+uint32_t CanStats::getFrameBits(const can::Frame& frame)
+{
+  // start of frame up to the end of the CRC, at most 118 bits for an extended frame
+  uint8_t bits[128];
+  int     n   = 0;
+  uint8_t len = std::min<uint8_t>(frame.len, 8);
+
+  pushBits(bits, &n, 0, 1);                           // start of frame
+  if (frame.extended) {
+    pushBits(bits, &n, (frame.id >> 18) & 0x7FF, 11);   // base id
+    pushBits(bits, &n, 0x3, 2);                       // SRR, IDE
+    pushBits(bits, &n, frame.id & 0x3FFFF, 18);       // id extension
+    pushBits(bits, &n, 0, 3);                         // RTR, r1, r0
+  } else {
+    pushBits(bits, &n, frame.id & 0x7FF, 11);
+    pushBits(bits, &n, 0, 3);                         // RTR, IDE, r0
+  }
+  pushBits(bits, &n, len, 4);
+  for (int i = 0; i < len; i++) {
+    pushBits(bits, &n, frame.data[i], 8);
+  }
+
+  uint16_t crc = 0;
+  for (int i = 0; i < n; i++) {
+    bool next = bits[i] ^ ((crc >> 14) & 1);
+    crc = (crc << 1) & 0x7FFF;
+    if (next) crc ^= kCrcPolynomial;
+  }
+  pushBits(bits, &n, crc, 15);
+
+  // after five equal bits the transmitter inserts one of opposite value, which starts a new run
+  uint32_t stuff_bits = 0;
+  uint8_t  last       = 2;
+  int      run        = 0;
+  for (int i = 0; i < n; i++) {
+    if (bits[i] == last) {
+      run++;
+    } else {
+      last = bits[i];
+      run  = 1;
+    }
+    if (run == 5) {
+      stuff_bits++;
+      last = !last;
+      run  = 1;
+    }
+  }
+  return n + stuff_bits + kTrailerBits;
+}
+
+CanStats::Entry& CanStats::getEntry(const can::Frame& frame)
+{
+  uint32_t key = frame.id | (frame.extended ? can::Frame::kExtendedMask : 0);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) return it->second;
+
+  Entry& entry = entries_[key];
+  entry.stats          = {};
+  entry.stats.id       = frame.id;
+  entry.stats.extended = frame.extended;
+  entry.last_rx        = 0;
+  return entry;
+}
+
+void CanStats::addBits(uint32_t bits, uint64_t time)
+{
+  bits_ += bits;
+  if (window_start_ == 0) window_start_ = time;
+  if (time >= window_start_ + kWindow) {
+    utilisation_  = static_cast<double>(window_bits_) * 1e6 / (bitrate_ * (time - window_start_));
+    window_start_ = time;
+    window_bits_  = 0;
+  }
+  window_bits_ += bits;
+}
+
+void CanStats::addReceived(const can::Frame& frame)
+{
+  uint32_t bits = getFrameBits(frame);
+
+  concurrent::ScopedLock L(&lock_);
+  Entry& entry = getEntry(frame);
+  if (entry.last_rx && frame.timestamp > entry.last_rx) {
+    entry.intervals.update(static_cast<double>(frame.timestamp - entry.last_rx));
+  }
+  entry.last_rx         = frame.timestamp;
+  entry.stats.last_seen = std::max(entry.stats.last_seen, frame.timestamp);
+  entry.stats.rx_frames++;
+  rx_frames_++;
+  addBits(bits, frame.timestamp);
+}
+
+void CanStats::addTransmitted(const can::Frame& frame, uint64_t time)
+{
+  uint32_t bits = getFrameBits(frame);
+
+  concurrent::ScopedLock L(&lock_);
+  Entry& entry = getEntry(frame);
+  entry.stats.last_seen = std::max(entry.stats.last_seen, time);
+  entry.stats.tx_frames++;
+  tx_frames_++;
+  addBits(bits, time);
+}
+
+void CanStats::addTransmitError(const can::Frame& frame)
+{
+  concurrent::ScopedLock L(&lock_);
+  getEntry(frame).stats.tx_errors++;
+}
+
+void CanStats::addErrorFrame(uint32_t error_class)
+{
+  concurrent::ScopedLock L(&lock_);
+  error_frames_++;
+  last_error_class_ = error_class;
+}
+
+can::BusStats CanStats::getSnapshot()
+{
+  uint64_t now = Timer::getTimeMicros();
+
+  concurrent::ScopedLock L(&lock_);
+  can::BusStats stats;
+  stats.rx_frames         = rx_frames_;
+  stats.tx_frames         = tx_frames_;
+  stats.error_frames      = error_frames_;
+  stats.last_error_class  = last_error_class_;
+  stats.bits              = bits_;
+  stats.bitrate           = bitrate_;
+  stats.utilisation       = utilisation_;
+  if (window_start_ && now >= window_start_ + kWindow) {
+    // nothing closed the window since, so it holds all traffic up to now
+    stats.utilisation = static_cast<double>(window_bits_) * 1e6
+                      / (bitrate_ * (now - window_start_));
+  }
+
+  stats.ids.reserve(entries_.size());
+  for (auto& item : entries_) {
+    can::IdStats id_stats = item.second.stats;
+    id_stats.mean_interval = item.second.intervals.getMean();
+    id_stats.jitter        = item.second.intervals.getStdDev();
+    stats.ids.push_back(id_stats);
+  }
+  std::sort(stats.ids.begin(), stats.ids.end(), byKey);
+  return stats;
+}
+
+}}}   // namespace hyped::utils::io
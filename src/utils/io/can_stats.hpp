@@ -0,0 +1,102 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * CanStats keeps per-id frame counters, receive interval jitter and last-seen times of one CAN
+ * bus, counts error frames reported by the controller and estimates bus utilisation. Every frame
+ * is charged with its exact length on the wire: the bits between start of frame and the end of
+ * the CRC are bit-stuffed as the CAN controller does, then delimiters, ACK, end of frame and
+ * interframe space are added.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef UTILS_IO_CAN_STATS_HPP_
+#define UTILS_IO_CAN_STATS_HPP_
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "utils/concurrent/lock.hpp"
+#include "utils/io/can.hpp"
+#include "utils/math/statistics.hpp"
+#include "utils/utils.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+class CanStats {
+ public:
+  static constexpr uint32_t kDefaultBitrate = 1000000;
+  static constexpr uint64_t kWindow         = 1000000;  // microseconds of utilisation averaging
+
+  explicit CanStats(uint32_t bitrate = kDefaultBitrate);
+  NO_COPY_ASSIGN(CanStats);
+
+  void setBitrate(uint32_t bitrate);
+
+  /**
+   * @brief Account a received frame, its timestamp is taken as arrival time
+   */
+  void addReceived(const can::Frame& frame);
+
+  /**
+   * @brief Account a frame written to the bus at time
+   */
+  void addTransmitted(const can::Frame& frame, uint64_t time);
+
+  void addTransmitError(const can::Frame& frame);
+
+  /**
+   * @param error_class - CAN_ERR_* bits of the error frame's id
+   */
+  void addErrorFrame(uint32_t error_class);
+
+  /**
+   * @brief Consistent copy of all counters. Utilisation is taken from the latest complete
+   * window, or from the current one if traffic stopped for longer than a window.
+   */
+  can::BusStats getSnapshot();
+
+  /**
+   * @return number of bit times frame occupies the bus, including stuff bits
+   * and interframe space
+   */
+  static uint32_t getFrameBits(const can::Frame& frame);
+
+ private:
+  struct Entry {
+    can::IdStats                    stats;
+    uint64_t                        last_rx;
+    math::OnlineStatistics<double>  intervals;
+  };
+
+  Entry& getEntry(const can::Frame& frame);   // lock_ must be held
+  void addBits(uint32_t bits, uint64_t time);   // lock_ must be held
+
+  std::unordered_map<uint32_t, Entry> entries_;   // key is id | kExtendedMask if extended
+  uint64_t          rx_frames_;
+  uint64_t          tx_frames_;
+  uint64_t          error_frames_;
+  uint32_t          last_error_class_;
+  uint64_t          bits_;
+  uint32_t          bitrate_;
+  uint64_t          window_start_;
+  uint64_t          window_bits_;
+  double            utilisation_;   // of the latest complete window
+  concurrent::Lock  lock_;
+};
+
+}}}   // namespace hyped::utils::io
+
+#endif  // UTILS_IO_CAN_STATS_HPP_
@@ -0,0 +1,188 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Prioritised CAN transmit queue served by a dedicated thread
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "utils/io/can_transmitter.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+constexpr size_t   CanTransmitter::kDefaultCapacity;
+constexpr uint32_t CanTransmitter::kMaxAttempts;
+constexpr uint64_t CanTransmitter::kInitialBackoff;
+constexpr uint64_t CanTransmitter::kMaxBackoff;
+
+CanTransmitter::CanTransmitter(Writer writer, Logger& log, size_t capacity)
+    : concurrent::Thread(log),
+      writer_(writer),
+      capacity_(capacity),
+      started_(false),
+      stopped_(false),
+      sequence_(0),
+      stats_()
+{ /* EMPTY */ }
+
+CanTransmitter::~CanTransmitter()
+{
+  stop();
+}
+
+void CanTransmitter::start()
+{
+  concurrent::ScopedLock L(&lock_);
+  if (started_ || stopped_) return;
+  started_ = true;
+  concurrent::Thread::start();
+}
+
+void CanTransmitter::stop()
+{
+  bool started;
+  std::vector<Entry> remaining;
+  {
+    concurrent::ScopedLock L(&lock_);
+    if (stopped_) return;
+    stopped_ = true;
+    started  = started_;
+    // without the thread nothing else fails the frames queued before start()
+    if (!started) remaining = takeQueue();
+    cv_.notifyAll();
+  }
+  if (started) join();
+  for (const Entry& entry : remaining) complete(entry, false);
+}
+
+bool CanTransmitter::enqueue(const can::Frame& frame, can::TxCallback callback)
+{
+  concurrent::ScopedLock L(&lock_);
+  if (stopped_ || queue_.size() >= capacity_) {
+    stats_.rejected++;
+    return false;
+  }
+
+  Entry entry = {frame, std::move(callback), getArbitrationKey(frame), sequence_++,
+                 Timer::getTimeMicros(), 0};
+  queue_.push(std::move(entry));
+  stats_.max_queue_depth = std::max<uint32_t>(stats_.max_queue_depth, queue_.size());
+  cv_.notify();
+  return true;
+}
+
+can::TxStats CanTransmitter::getStats()
+{
+  concurrent::ScopedLock L(&lock_);
+  can::TxStats stats = stats_;
+  stats.queue_depth  = queue_.size();
+  return stats;
+}
+
+uint32_t CanTransmitter::getArbitrationKey(const can::Frame& frame)
+{
+  // identifier bits in wire order: 11 bit base id, IDE bit (recessive for extended), 18 bit rest
+  if (!frame.extended) return (frame.id & 0x7FF) << 19;
+  uint32_t base = (frame.id >> 18) & 0x7FF;
+  return (base << 19) | (1 << 18) | (frame.id & 0x3FFFF);
+}
+
+void CanTransmitter::run()
+{
+  log_.INFO("CAN", "starting transmit thread");
+  lock_.lock();
+  while (!stopped_) {
+    if (queue_.empty()) {
+      cv_.wait(&lock_);
+      continue;
+    }
+
+    Entry entry = queue_.top();
+    queue_.pop();
+    lock_.unlock();
+
+    int error = writer_(entry.frame);
+    entry.attempts++;
+
+    if (error == 0) {
+      complete(entry, true);
+    } else if ((error == ENOBUFS || error == EAGAIN) && entry.attempts < kMaxAttempts) {
+      lock_.lock();
+      stats_.retries++;
+      queue_.push(entry);   // same key and sequence, so it keeps its place
+      backoff(entry.attempts);
+      continue;
+    } else {
+      log_.ERR("CAN", "could not send frame with id %u after %u attempts: %s",
+          entry.frame.id, entry.attempts, strerror(error));
+      complete(entry, false);
+    }
+    lock_.lock();
+  }
+
+  std::vector<Entry> remaining = takeQueue();
+  lock_.unlock();
+
+  for (const Entry& entry : remaining) complete(entry, false);
+  log_.INFO("CAN", "stopped transmit thread, %zu frames dropped", remaining.size());
+}
+
+std::vector<CanTransmitter::Entry> CanTransmitter::takeQueue()
+{
+  std::vector<Entry> entries;
+  while (!queue_.empty()) {
+    entries.push_back(queue_.top());
+    queue_.pop();
+  }
+  return entries;
+}
+
+void CanTransmitter::backoff(uint32_t attempts)
+{
+  uint64_t delay    = std::min(kInitialBackoff << (attempts - 1), kMaxBackoff);
+  uint64_t deadline = Timer::getTimeMicros() + delay;
+  uint64_t now      = Timer::getTimeMicros();
+  while (!stopped_ && now < deadline) {
+    cv_.waitFor(&lock_, deadline - now);
+    now = Timer::getTimeMicros();
+  }
+}
+
+void CanTransmitter::complete(const Entry& entry, bool sent)
+{
+  uint64_t latency = Timer::getTimeMicros() - entry.enqueued_at;
+  {
+    concurrent::ScopedLock L(&lock_);
+    if (sent) {
+      stats_.sent++;
+      stats_.last_latency = latency;
+      stats_.max_latency  = std::max(stats_.max_latency, latency);
+      stats_.mean_latency += (latency - stats_.mean_latency) / stats_.sent;
+    } else {
+      stats_.failed++;
+    }
+  }
+  if (entry.callback) entry.callback(entry.frame, sent);
+}
+
+}}}   // namespace hyped::utils::io
@@ -0,0 +1,130 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * CanTransmitter owns the transmit side of a CAN socket. Frames are queued by any thread and
+ * written by a dedicated thread in bus arbitration order, i.e. the frame that would win
+ * arbitration on the wire is written first. Writes failing with ENOBUFS/EAGAIN (full socket
+ * or interface queue) are retried with exponential backoff.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef UTILS_IO_CAN_TRANSMITTER_HPP_
+#define UTILS_IO_CAN_TRANSMITTER_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "utils/concurrent/condition_variable.hpp"
+#include "utils/concurrent/lock.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/io/can.hpp"
+#include "utils/logger.hpp"
+#include "utils/utils.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+class CanTransmitter : public concurrent::Thread {
+ public:
+  typedef can::Writer Writer;
+
+  static constexpr size_t   kDefaultCapacity  = 256;
+  static constexpr uint32_t kMaxAttempts      = 8;
+  static constexpr uint64_t kInitialBackoff   = 100;    // microseconds, doubled on every retry
+  static constexpr uint64_t kMaxBackoff       = 10000;
+
+  CanTransmitter(Writer writer, Logger& log, size_t capacity = kDefaultCapacity);
+  ~CanTransmitter();
+  NO_COPY_ASSIGN(CanTransmitter);
+
+  /**
+   * @brief Start the transmit thread, frames queued before are sent once it runs
+   */
+  void start();
+
+  /**
+   * @brief Queue frame for transmission
+   *
+   * @param  frame    data to be sent
+   * @param  callback optional, notified from the transmit thread once the frame is done
+   * @return false    iff the queue is full or the transmitter has been stopped
+   */
+  bool enqueue(const can::Frame& frame, can::TxCallback callback = nullptr);
+
+  /**
+   * @brief Stop the transmit thread. Frames still queued are failed, their callbacks notified.
+   */
+  void stop();
+
+  can::TxStats getStats();
+
+  /**
+   * @return key ordering frames like CAN arbitration does, lower key wins. Standard frames win
+   * over extended frames sharing the same 11 bit base id.
+   */
+  static uint32_t getArbitrationKey(const can::Frame& frame);
+
+  void run() override;
+
+ private:
+  struct Entry {
+    can::Frame      frame;
+    can::TxCallback callback;
+    uint32_t        key;          // see getArbitrationKey()
+    uint64_t        sequence;     // FIFO among frames with equal key
+    uint64_t        enqueued_at;
+    uint32_t        attempts;
+  };
+
+  struct EntryOrder {
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+      if (a.key != b.key) return a.key > b.key;
+      return a.sequence > b.sequence;
+    }
+  };
+
+  /**
+   * @brief Wait until the backoff for the given retry attempt has passed or stop() is called.
+   * Has to be called with lock_ held.
+   */
+  void backoff(uint32_t attempts);
+
+  /**
+   * @brief Empty the queue in transmission order. Has to be called with lock_ held.
+   */
+  std::vector<Entry> takeQueue();
+
+  /**
+   * @brief Notify callback and update statistics, called without lock_ held
+   */
+  void complete(const Entry& entry, bool sent);
+
+  Writer                                                      writer_;
+  size_t                                                      capacity_;
+  bool                                                        started_;
+  bool                                                        stopped_;
+  uint64_t                                                    sequence_;
+  std::priority_queue<Entry, std::vector<Entry>, EntryOrder>  queue_;
+  can::TxStats                                                stats_;
+  concurrent::Lock                                            lock_;
+  concurrent::ConditionVariable                               cv_;
+};
+
+}}}   // namespace hyped::utils::io
+
+#endif  // UTILS_IO_CAN_TRANSMITTER_HPP_
@@ -140,6 +140,8 @@ class GPIO {
   uint32_t           pin_mask_;   // mask for register access to this pin
   int                fd_;         // file pointer to /sys/class/gpio/gpioXX/value
 
+  friend class GpioMonitor;       // waits on fd_ of many pins at once
+
   NO_COPY_ASSIGN(GPIO);
 };
 
@@ -0,0 +1,143 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Watches input GPIOs for edges from a single thread
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "utils/io/gpio_monitor.hpp"
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+namespace {
+constexpr uint32_t kStopIndex = UINT32_MAX;   // epoll data of stop_fd_
+}
+
+constexpr int GpioMonitor::kMaxEvents;
+
+GpioMonitor::GpioMonitor(Logger& log)
+    : Thread(log),
+      epoll_fd_(epoll_create1(0)),
+      stop_fd_(eventfd(0, EFD_NONBLOCK)),
+      stopped_(false)
+{
+  if (epoll_fd_ < 0 || stop_fd_ < 0) {
+    log_.ERR("GPIO-MONITOR", "could not set up epoll: %d", errno);
+    return;
+  }
+  epoll_event event = {};
+  event.events   = EPOLLIN;
+  event.data.u32 = kStopIndex;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &event);
+}
+
+GpioMonitor::~GpioMonitor()
+{
+  if (stop_fd_ >= 0)  close(stop_fd_);
+  if (epoll_fd_ >= 0) close(epoll_fd_);
+}
+
+bool GpioMonitor::watch(GPIO* gpio, Listener* listener)
+{
+  // fd_ stays 0 if GPIO could not open the value file
+  if (gpio->fd_ <= 0) {
+    log_.ERR("GPIO-MONITOR", "gpio %d has no value file to wait on", gpio->pin_);
+    return false;
+  }
+  return watch(gpio->fd_, listener);
+}
+
+bool GpioMonitor::watch(int fd, Listener* listener)
+{
+  if (epoll_fd_ < 0) return false;
+
+  // sysfs signals a new value with EPOLLPRI, edge triggering keeps the always readable value
+  // file from waking the thread when nothing changed
+  epoll_event event = {};
+  event.events   = EPOLLPRI | EPOLLIN | EPOLLET;
+  event.data.u32 = watches_.size();
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+    log_.ERR("GPIO-MONITOR", "could not watch fd %d: %d", fd, errno);
+    return false;
+  }
+
+  // the value file must be read once before the first edge is reported
+  int8_t value = readValue(fd);
+  Watch watch  = {fd, listener, static_cast<uint8_t>(value > 0)};
+  watches_.push_back(watch);
+  listener->onEdge(watch.value, Timer::getTimeMicros());
+  return true;
+}
+
+void GpioMonitor::run()
+{
+  epoll_event events[kMaxEvents];
+  log_.INFO("GPIO-MONITOR", "watching %u gpios", static_cast<uint32_t>(watches_.size()));
+
+  while (!stopped_) {
+    int count = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      log_.ERR("GPIO-MONITOR", "epoll_wait failed: %d", errno);
+      break;
+    }
+
+    // all edges of one wake up share its time, the earliest the thread could have seen them
+    uint64_t time = Timer::getTimeMicros();
+    for (int i = 0; i < count; i++) {
+      if (events[i].data.u32 == kStopIndex) {
+        stopped_ = true;
+        continue;
+      }
+      Watch& watch = watches_[events[i].data.u32];
+      int8_t value = readValue(watch.fd);
+      // a pin that bounced back before it was read has not changed
+      if (value < 0 || value == static_cast<int8_t>(watch.value)) continue;
+      watch.value = value;
+      watch.listener->onEdge(watch.value, time);
+    }
+  }
+}
+
+void GpioMonitor::stop()
+{
+  stopped_ = true;
+  uint64_t one = 1;
+  if (stop_fd_ >= 0) write(stop_fd_, &one, sizeof(one));
+}
+
+int8_t GpioMonitor::readValue(int fd)
+{
+  // a sysfs value file is read from the start, a pipe is drained as edge triggering requires
+  char    buf[16];
+  int8_t  value = -1;
+  ssize_t length;
+  lseek(fd, 0, SEEK_SET);
+  while ((length = read(fd, buf, sizeof(buf))) > 0) {
+    for (ssize_t i = 0; i < length; i++) {
+      if (buf[i] == '0' || buf[i] == '1') value = buf[i] - '0';
+    }
+  }
+  return value;
+}
+
+}}}   // namespace hyped::utils::io
@@ -0,0 +1,100 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Watches input GPIOs for edges from a single thread. The value files of the pins are set up for
+ * edge triggered waits by GPIO, exactly as for GPIO::wait(), but instead of one blocked thread
+ * per pin they are all multiplexed through one epoll set. Every change of a value is handed to
+ * its listener together with the time the thread woke up, within microseconds of the edge.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef UTILS_IO_GPIO_MONITOR_HPP_
+#define UTILS_IO_GPIO_MONITOR_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "utils/concurrent/thread.hpp"
+#include "utils/io/gpio.hpp"
+#include "utils/logger.hpp"
+#include "utils/utils.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+class GpioMonitor : public concurrent::Thread {
+ public:
+  class Listener {
+   public:
+    /**
+     * @brief Called from the monitor thread on every change of the watched value
+     * @param time - microseconds of utils::Timer when the change was picked up
+     */
+    virtual void onEdge(uint8_t value, uint64_t time) = 0;
+    virtual ~Listener() {}
+  };
+
+  static constexpr int kMaxEvents = 8;      // edges handled per wake up
+
+  explicit GpioMonitor(Logger& log);
+  ~GpioMonitor();
+
+  /**
+   * @brief Hand every edge of the input pin to listener. The listener is called once straight
+   * away with the current value. Must be called before start().
+   * @return false if the pin has no value file to wait on
+   */
+  bool watch(GPIO* gpio, Listener* listener);
+
+  /**
+   * @brief As above for any file descriptor that reads like a gpio value file and signals new
+   * values with EPOLLPRI or EPOLLIN, e.g. a pipe in tests
+   */
+  bool watch(int fd, Listener* listener);
+
+  /**
+   * @brief Wait for edges until stop() is called
+   */
+  void run() override;
+
+  /**
+   * @brief Wake the monitor thread and let run() return, join() it afterwards
+   */
+  void stop();
+
+ private:
+  struct Watch {
+    int       fd;
+    Listener* listener;
+    uint8_t   value;
+  };
+
+  /**
+   * @return last value written to fd, -1 if there was none
+   */
+  static int8_t readValue(int fd);
+
+  int                epoll_fd_;
+  int                stop_fd_;          // eventfd written by stop()
+  std::vector<Watch> watches_;
+  std::atomic<bool>  stopped_;
+
+  NO_COPY_ASSIGN(GpioMonitor);
+};
+
+}}}   // namespace hyped::utils::io
+
+#endif  // UTILS_IO_GPIO_MONITOR_HPP_
@@ -0,0 +1,67 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Histogram with power of two buckets
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "utils/math/histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace hyped {
+namespace utils {
+namespace math {
+
+constexpr int Histogram::kNumBuckets;
+
+Histogram::Histogram()
+    : buckets_(),
+      count_(0),
+      sum_(0),
+      min_(UINT64_MAX),
+      max_(0)
+{}
+
+void Histogram::add(uint64_t value)
+{
+  int bucket = 0;
+  while (bucket < kNumBuckets - 1 && value > getUpperBound(bucket)) bucket++;
+  buckets_[bucket]++;
+  count_++;
+  sum_ += value;
+  min_  = std::min(min_, value);
+  max_  = std::max(max_, value);
+}
+
+uint64_t Histogram::getPercentile(double share) const
+{
+  if (count_ == 0) return 0;
+
+  uint32_t rank  = std::max(1.0, std::ceil(share * count_));
+  uint32_t total = 0;
+  for (int bucket = 0; bucket < kNumBuckets; bucket++) {
+    total += buckets_[bucket];
+    if (total >= rank) return std::max(min_, std::min(max_, getUpperBound(bucket)));
+  }
+  return max_;
+}
+
+uint64_t Histogram::getUpperBound(int bucket)
+{
+  if (bucket >= kNumBuckets - 1) return UINT64_MAX;
+  return (static_cast<uint64_t>(1) << bucket) - 1;
+}
+
+}}}  // namespace hyped::utils::math
@@ -0,0 +1,66 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Histogram of durations or other non-negative integers with power of two buckets. It has a fixed
+ * size, so it can be added to on every tick and copied through Data like any other struct.
+ * Percentiles are exact to within a factor of two and never beyond the largest value seen.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef UTILS_MATH_HISTOGRAM_HPP_
+#define UTILS_MATH_HISTOGRAM_HPP_
+
+#include <cstdint>
+
+namespace hyped {
+namespace utils {
+namespace math {
+
+class Histogram {
+ public:
+  // bucket 0 counts zeros, bucket i values in [2^(i-1), 2^i), the last one everything above
+  static constexpr int kNumBuckets = 32;
+
+  Histogram();
+
+  void add(uint64_t value);
+
+  uint32_t getCount() const { return count_; }
+  uint64_t getMin() const { return count_ ? min_ : 0; }
+  uint64_t getMax() const { return max_; }
+  double   getMean() const { return count_ ? static_cast<double>(sum_) / count_ : 0; }
+  uint32_t getBucket(int bucket) const { return buckets_[bucket]; }
+
+  /**
+   * @param share - in [0, 1], e.g. 0.99 for the 99th percentile
+   * @return upper bound of the bucket holding the percentile, clamped to the values seen
+   */
+  uint64_t getPercentile(double share) const;
+
+  /**
+   * @return largest value counted in bucket
+   */
+  static uint64_t getUpperBound(int bucket);
+
+ private:
+  uint32_t buckets_[kNumBuckets];
+  uint32_t count_;
+  uint64_t sum_;
+  uint64_t min_;
+  uint64_t max_;
+};
+
+}}}  // namespace hyped::utils::math
+
+#endif  // UTILS_MATH_HISTOGRAM_HPP_
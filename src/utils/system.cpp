@@ -74,6 +74,8 @@ void printUsage()
     "    --official_run, --elevator_run, --stationary_run, --outside_run\n"
     "    To disable telemetry module.\n"
     "    --telemetry_off\n"
+    "    To record all CAN traffic to a binary file, see utils/io/can_recorder.hpp.\n"
+    "    --can_record=<file>\n"
     "");
 }
 }   // namespace hyped::utils::System
@@ -122,6 +124,7 @@ System::System(int argc, char* argv[])
       config(0)
 {
   strncpy(config_file, DEFAULT_CONFIG, 250);
+  can_record_file[0] = '\0';
 
   int c;
   int option_index = 0;
@@ -163,6 +166,7 @@ System::System(int argc, char* argv[])
       {"stationary_run", no_argument, 0, 't'},
       {"outside_run", no_argument, 0, 'w'},
       {"telemetry_off", no_argument, 0, 'x'},
+      {"can_record", required_argument, 0, 'y'},
       {0, 0, 0, 0}
     };    // options for long in long_options array, can support optional argument
     // returns option character from argv array following '-' or '--' from command line
@@ -330,6 +334,10 @@ System::System(int argc, char* argv[])
         if (optarg) telemetry_off = atoi(optarg);
         else        telemetry_off = 1;
         break;
+      case 'y':   // can_record
+        strncpy(can_record_file, optarg, 250-1);
+        can_record_file[250-1] = '\0';
+        break;
       default:
         printUsage();
         exit(1);
@@ -385,6 +393,7 @@ static void gracefulExit(int x)
 {
   System& sys = System::getSystem();
   sys.running_ = false;
+  sys.navigation_motors_sync_.requestCancel();
 
   Logger log(true, 0);
   log.INFO("SYSTEM", "termination signal received, exiting gracefully");
@@ -396,6 +405,7 @@ static void segfaultHandler(int x)
   // start turning the system off
   System& sys = System::getSystem();
   sys.running_ = false;
+  sys.navigation_motors_sync_.requestCancel();
 
   Logger log(true, 0);
   log.ERR("SYSTEM", "forced termination detected (segfault?)");
@@ -98,12 +98,16 @@ class System {
   // Telemetry
   bool telemetry_off;
 
+  // CAN traffic recording, empty if disabled
+  char can_record_file[250];
+
   // barriers
   /**
    * @brief Barrier used by navigation and motor control modules on stm transition to accelerating
    *        state. Navigation must finish calibration before motors start spinning.
+   *        Cancelled on shutdown so that neither module can be left waiting for the other.
    */
-  Barrier navigation_motors_sync_ = Barrier(2);
+  Barrier navigation_motors_sync_ {2};
   bool running_;
 
   char    config_file[250];
@@ -22,6 +22,8 @@
 
 #include <sys/time.h>
 
+#include "utils/clock.hpp"
+
 namespace hyped {
 namespace utils {
 
@@ -34,6 +36,9 @@ uint64_t Timer::time_start_ = Timer::getTimeMicros();
 
 uint64_t Timer::getTimeMicros()
 {
+  SimulationClock* clock = SimulationClock::getInstalled();
+  if (clock) return clock->getTimeMicros();
+
   timeval tv;
   if (gettimeofday(&tv, (struct timezone *)0) < 0) {
     return 0;
@@ -41,6 +46,16 @@ uint64_t Timer::getTimeMicros()
   return (static_cast<uint64_t>(tv.tv_sec)* 1000000) + tv.tv_usec - time_start_;
 }
 
+uint64_t Timer::fromEpochMicros(uint64_t epoch_micros)
+{
+  return epoch_micros - time_start_;
+}
+
+uint64_t Timer::toEpochMicros(uint64_t micros)
+{
+  return micros + time_start_;
+}
+
 Timer::Timer()
     : elapsed_(0),
       start_(0),
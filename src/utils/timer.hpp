@@ -31,8 +31,25 @@ namespace utils {
 class Timer {
  public:
   // static uint64_t getTimeMillis();
+  /**
+   * @return microseconds since the start of the process, or the time of the installed
+   * SimulationClock. Installing or uninstalling one makes the time jump.
+   */
   static uint64_t getTimeMicros();
 
+  /**
+   * @brief Convert a wall clock time, e.g. a kernel timestamp, to the time base
+   * used by getTimeMicros()
+   *
+   * @param epoch_micros - microseconds since the Unix epoch
+   */
+  static uint64_t fromEpochMicros(uint64_t epoch_micros);
+
+  /**
+   * @brief Inverse of fromEpochMicros()
+   */
+  static uint64_t toEpochMicros(uint64_t micros);
+
   Timer();
 
   void start();
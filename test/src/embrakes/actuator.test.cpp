@@ -0,0 +1,131 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests the non-blocking brake actuation with deadlines
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "embrakes/actuator.hpp"
+#include "embrakes/interface.hpp"
+#include "gtest/gtest.h"
+
+namespace hyped {
+namespace embrakes {
+
+/**
+ * @brief A brake whose button the test moves, counting what it is asked to do
+ */
+class ScriptedStepper : public StepperInterface {
+ public:
+  ScriptedStepper()
+      : clamps_(0), retracts_(0), acc_checks_(0), braking_checks_(0), clamped_(true),
+        button_(false) {}
+
+  void checkHome() override {}
+  void sendRetract() override
+  {
+    retracts_++;
+    clamped_ = false;
+  }
+  void sendClamp() override
+  {
+    clamps_++;
+    clamped_ = true;
+  }
+  void checkAccFailure() override { acc_checks_++; }
+  void checkBrakingFailure() override { braking_checks_++; }
+  bool checkClamped() override { return clamped_; }
+  bool checkRetracted() override { return button_; }
+
+  void setButton(bool retracted) { button_ = retracted; }
+
+  int clamps_;
+  int retracts_;
+  int acc_checks_;
+  int braking_checks_;
+
+ private:
+  bool clamped_;
+  bool button_;
+};
+
+class ActuatorTest : public ::testing::Test {
+ protected:
+  ActuatorTest() : log_(false, -1), actuator_(log_, &stepper_, 1) {}
+
+  utils::Logger   log_;
+  ScriptedStepper stepper_;
+  Actuator        actuator_;
+};
+
+TEST_F(ActuatorTest, sendsCommandOnceWithoutWaiting)
+{
+  actuator_.command(Actuator::Command::kRetract, 0);
+  ASSERT_EQ(stepper_.retracts_, 1);
+  actuator_.command(Actuator::Command::kRetract, 1000);
+  actuator_.command(Actuator::Command::kNone, 2000);
+  ASSERT_EQ(stepper_.retracts_, 1);
+  ASSERT_EQ(actuator_.getTarget(), Actuator::Command::kRetract);
+  ASSERT_FALSE(actuator_.isConfirmed());
+}
+
+TEST_F(ActuatorTest, measuresLatencyToConfirmation)
+{
+  actuator_.command(Actuator::Command::kRetract, 1000000);
+  actuator_.update(1100000);
+  ASSERT_FALSE(actuator_.isConfirmed());
+  ASSERT_EQ(actuator_.getLatency(), 0u);
+
+  stepper_.setButton(true);
+  actuator_.update(1300000);
+  ASSERT_TRUE(actuator_.isConfirmed());
+  ASSERT_EQ(actuator_.getLatency(), 300000u);
+  ASSERT_EQ(stepper_.acc_checks_, 0);
+}
+
+TEST_F(ActuatorTest, checksFailureAtDeadline)
+{
+  actuator_.command(Actuator::Command::kRetract, 0);
+  actuator_.update(Actuator::kDeadline - 1);
+  ASSERT_EQ(stepper_.acc_checks_, 0);
+  actuator_.update(Actuator::kDeadline);
+  ASSERT_EQ(stepper_.acc_checks_, 1);
+  ASSERT_FALSE(actuator_.isConfirmed());
+
+  // then keeps checking, at the monitor period and not on every update
+  actuator_.update(Actuator::kDeadline + 1000);
+  ASSERT_EQ(stepper_.acc_checks_, 1);
+  actuator_.update(Actuator::kDeadline + Actuator::kMonitorPeriod);
+  ASSERT_EQ(stepper_.acc_checks_, 2);
+  ASSERT_EQ(stepper_.braking_checks_, 0);
+}
+
+TEST_F(ActuatorTest, newCommandReplacesPendingOne)
+{
+  stepper_.setButton(false);
+  actuator_.command(Actuator::Command::kRetract, 0);
+  actuator_.update(10000);
+
+  // told to stop while still retracting, the brake clamps at once
+  actuator_.command(Actuator::Command::kClamp, 20000);
+  ASSERT_EQ(stepper_.clamps_, 1);
+  actuator_.update(20000);
+  ASSERT_TRUE(actuator_.isConfirmed());
+  ASSERT_EQ(actuator_.getLatency(), 0u);
+
+  actuator_.update(20000 + Actuator::kDeadline);
+  ASSERT_EQ(stepper_.acc_checks_, 0);
+  ASSERT_EQ(stepper_.braking_checks_, 1);
+}
+
+}}  // namespace hyped::embrakes
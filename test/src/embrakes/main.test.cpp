@@ -0,0 +1,107 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that the embrakes thread reacts to new states without waiting for brakes
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "data/data.hpp"
+#include "embrakes/main.hpp"
+#include "gtest/gtest.h"
+#include "utils/concurrent/thread.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace embrakes {
+
+class EmbrakesMainTest : public ::testing::Test {
+ protected:
+  EmbrakesMainTest() : log_(false, -1), sys_(utils::System::getSystem()),
+                       data_(data::Data::getInstance()) {}
+
+  void SetUp() override
+  {
+    fake_embrakes_     = sys_.fake_embrakes;
+    sys_.fake_embrakes = true;
+    sys_.running_      = true;
+    setState(data::State::kIdle);
+    main_ = new Main(1, log_);
+    main_->start();
+  }
+
+  void TearDown() override
+  {
+    sys_.running_ = false;
+    main_->join();
+    delete main_;
+    setState(data::State::kIdle);
+    data_.setEmergencyBrakesData(data::EmergencyBrakes());
+    sys_.running_      = true;
+    sys_.fake_embrakes = fake_embrakes_;
+  }
+
+  void setState(data::State state)
+  {
+    data::StateMachine sm_data = data_.getStateMachineData();
+    sm_data.current_state = state;
+    data_.setStateMachineData(sm_data);
+  }
+
+  /**
+   * @return microseconds until both brakes report retracted, or clamped, 0 if not within 2 s
+   */
+  uint64_t waitForBrakes(bool retracted)
+  {
+    uint64_t start = utils::Timer::getTimeMicros();
+    while (utils::Timer::getTimeMicros() - start < 2000000) {
+      data::EmergencyBrakes brakes = data_.getEmergencyBrakesData();
+      if (brakes.brakes_retracted[0] == retracted && brakes.brakes_retracted[1] == retracted) {
+        return utils::Timer::getTimeMicros() - start + 1;
+      }
+      utils::concurrent::Thread::sleep(1);
+    }
+    return 0;
+  }
+
+  utils::Logger   log_;
+  utils::System&  sys_;
+  data::Data&     data_;
+  Main*           main_;
+  bool            fake_embrakes_;
+};
+
+TEST_F(EmbrakesMainTest, clampsWithinTickOfEmergency)
+{
+  setState(data::State::kCalibrating);
+  ASSERT_GT(waitForBrakes(true), 0u);
+
+  // the brakes used to be checked only after waiting kBrakeCommandWaitTime
+  setState(data::State::kEmergencyBraking);
+  uint64_t latency = waitForBrakes(false);
+  ASSERT_GT(latency, 0u);
+  ASSERT_LT(latency, 50000u);
+}
+
+TEST_F(EmbrakesMainTest, reportsReadyOnceBothRetracted)
+{
+  setState(data::State::kCalibrating);
+  ASSERT_GT(waitForBrakes(true), 0u);
+  uint64_t start = utils::Timer::getTimeMicros();
+  while (data_.getEmergencyBrakesData().module_status != data::ModuleStatus::kReady) {
+    ASSERT_LT(utils::Timer::getTimeMicros() - start, 50000u);
+    utils::concurrent::Thread::sleep(1);
+  }
+}
+
+}}  // namespace hyped::embrakes
@@ -0,0 +1,301 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests SDO request/response matching in CanSender over a socketpair bus
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <sys/socket.h>
+#include <time.h>
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "propulsion/can/can_sender.hpp"
+#include "propulsion/controller_interface.hpp"
+#include "utils/io/can.hpp"
+#include "utils/logger.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+using utils::io::can::Frame;
+
+/**
+ * @brief Controller end of the bus. Answers every SDO request after an unrelated status
+ * response, or aborts it, or stays silent, or ignores the first attempt of every request,
+ * or holds requests back until kBatch of them are outstanding.
+ */
+class SdoResponder : public utils::io::CanProccesor {
+ public:
+  enum Mode { kAnswer, kAbort, kSilent, kDropFirst, kBatch };
+
+  SdoResponder(Can* can, uint8_t node_id)
+      : mode_(kAnswer),
+        batch_(0),
+        max_held_(0),
+        can_(can),
+        node_id_(node_id)
+  {}
+
+  void processNewData(Frame& message) override
+  {
+    if (mode_ == kSilent) return;
+    if (mode_ == kDropFirst) {
+      uint32_t key = message.data[1] | (message.data[2] << 8) | (message.data[3] << 16);
+      if (std::find(seen_.begin(), seen_.end(), key) == seen_.end()) {
+        seen_.push_back(key);
+        return;
+      }
+    }
+    if (mode_ == kBatch) {
+      held_.push_back(message);
+      max_held_ = std::max<uint32_t>(max_held_, held_.size());
+      if (held_.size() < batch_) return;
+      for (Frame& request : held_) answer(request);
+      held_.clear();
+      return;
+    }
+    answer(message);
+  }
+
+  bool hasId(uint32_t id, bool extended) override { return id == kSdoReceive + node_id_; }
+
+  std::atomic<Mode>     mode_;
+  uint32_t              batch_;
+  std::atomic<uint32_t> max_held_;
+
+ private:
+  void answer(const Frame& message)
+  {
+    Frame response = {};
+    response.id  = kSdoTransmit + node_id_;
+    response.len = 8;
+    if (mode_ != kAbort) {
+      // statusword 0x6041 first, the sender must keep waiting for its own index
+      response.data[0] = 0x4B;
+      response.data[1] = 0x41;
+      response.data[2] = 0x60;
+      response.data[4] = 0x27;
+      can_->send(response);
+      Thread::sleep(5);
+    }
+
+    response.data[0] = mode_ == kAbort ? 0x80 : 0x4F;
+    response.data[1] = message.data[1];
+    response.data[2] = message.data[2];
+    response.data[3] = message.data[3];
+    response.data[4] = 0x2A;
+    can_->send(response);
+  }
+
+  Can*                  can_;
+  uint8_t               node_id_;
+  std::vector<uint32_t> seen_;
+  std::vector<Frame>    held_;
+};
+
+/**
+ * @brief Counts the SDO responses and PDOs handed to the controller
+ */
+class CountingController : public ControllerInterface {
+ public:
+  CountingController() : responses_(0), pdos_(0) {}
+
+  void processSdoMessage(Frame& message) override { responses_++; }
+  void registerController() override {}
+  void configure() override {}
+  void enterOperational() override {}
+  void enterPreOperational() override {}
+  void checkState() override {}
+  void sendTargetVelocity(int32_t target_velocity) override {}
+  void updateActualVelocity() override {}
+  int32_t getVelocity() override { return 0; }
+  void quickStop() override {}
+  void healthCheck() override {}
+  bool getFailure() override { return false; }
+  void updateMotorTemp() override {}
+  uint8_t getMotorTemp() override { return 0; }
+  ControllerState getControllerState() override { return kSwitchOnDisabled; }
+  void processEmergencyMessage(Frame& message) override {}
+  void processErrorMessage(uint16_t error_message) override {}
+  void processNmtMessage(Frame& message) override {}
+  void processPdoMessage(Frame& message) override { pdos_++; }
+  void requestStateTransition(Frame& message, ControllerState state) override {}
+
+  std::atomic<uint32_t> responses_;
+  std::atomic<uint32_t> pdos_;
+};
+
+class CanSenderTest : public ::testing::Test {
+ protected:
+  CanSenderTest() : log_(false, -1) {}
+
+  void SetUp() override
+  {
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+    bus_.reset(new Can(fds[0]));
+    peer_.reset(new Can(fds[1]));
+    responder_.reset(new SdoResponder(peer_.get(), kNode));
+    sender_.reset(new CanSender(&controller_, kNode, log_, *bus_));
+    sender_->registerController();
+    peer_->registerProcessor(responder_.get());
+    peer_->start();
+  }
+
+  void TearDown() override
+  {
+    bus_.reset();   // before the processors registered with them
+    peer_.reset();
+  }
+
+  static Frame makeRequest(uint16_t index, uint8_t sub_index)
+  {
+    Frame request = {};
+    request.id      = kSdoReceive + kNode;
+    request.len     = 8;
+    request.data[0] = 0x40;
+    request.data[1] = index & 0xFF;
+    request.data[2] = index >> 8;
+    request.data[3] = sub_index;
+    return request;
+  }
+
+  static uint64_t getThreadCpuMicros()
+  {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec * 1000000ULL + time.tv_nsec / 1000;
+  }
+
+  static constexpr uint8_t kNode = 3;
+
+  Logger                          log_;
+  CountingController              controller_;
+  std::unique_ptr<SdoResponder>   responder_;
+  std::unique_ptr<CanSender>      sender_;
+  std::unique_ptr<Can>            bus_;
+  std::unique_ptr<Can>            peer_;
+};
+
+constexpr uint8_t CanSenderTest::kNode;
+
+TEST_F(CanSenderTest, deliversResponseWithMatchingIndex)
+{
+  Frame response;
+  ASSERT_TRUE(sender_->sendSdo(makeRequest(0x606C, 0), &response));
+  ASSERT_EQ(response.id, kSdoTransmit + kNode);
+  ASSERT_EQ(response.data[0], 0x4F);
+  ASSERT_EQ(response.data[1], 0x6C);
+  ASSERT_EQ(response.data[2], 0x60);
+  ASSERT_EQ(response.data[4], 0x2A);
+  ASSERT_EQ(controller_.responses_, 2u);    // unrelated status response included
+  ASSERT_FALSE(sender_->getIsSending());
+}
+
+TEST_F(CanSenderTest, deliversAbort)
+{
+  responder_->mode_ = SdoResponder::kAbort;
+  Frame response;
+  ASSERT_TRUE(sender_->sendSdo(makeRequest(0x2026, 1), &response));
+  ASSERT_EQ(response.data[0], 0x80);
+  ASSERT_EQ(response.data[3], 1);
+}
+
+TEST_F(CanSenderTest, sleepsUntilTimeout)
+{
+  responder_->mode_ = SdoResponder::kSilent;
+  Frame request = makeRequest(0x6041, 0);
+
+  uint64_t start = utils::Timer::getTimeMicros();
+  uint64_t cpu   = getThreadCpuMicros();
+  ASSERT_FALSE(sender_->sendSdo(request, nullptr, 50000));
+  uint64_t elapsed = utils::Timer::getTimeMicros() - start;
+  cpu = getThreadCpuMicros() - cpu;
+
+  ASSERT_GE(elapsed, 50000u);
+  ASSERT_LT(cpu, elapsed / 10);   // waiting does not spin
+  ASSERT_FALSE(sender_->getIsSending());
+}
+
+TEST_F(CanSenderTest, doesNotWaitForUnconfirmedMessages)
+{
+  responder_->mode_ = SdoResponder::kSilent;
+  Frame nmt = {};
+  nmt.id  = kNmtReceive;
+  nmt.len = 2;
+
+  uint64_t start = utils::Timer::getTimeMicros();
+  ASSERT_TRUE(sender_->sendMessage(nmt));
+  ASSERT_LT(utils::Timer::getTimeMicros() - start, 10000u);
+}
+
+TEST_F(CanSenderTest, keepsWindowOfRequestsInFlight)
+{
+  responder_->mode_  = SdoResponder::kBatch;
+  responder_->batch_ = 4;
+  std::vector<Frame> requests;
+  for (uint8_t i = 0; i < 24; i++) requests.push_back(makeRequest(0x2040, i));
+
+  // answered only when 4 requests are outstanding, i.e. never without pipelining
+  uint64_t start = utils::Timer::getTimeMicros();
+  std::vector<Frame> responses;
+  ASSERT_TRUE(sender_->sendSdos(requests, &responses, 4, 1000000));
+  ASSERT_LT(utils::Timer::getTimeMicros() - start, 1000000u);
+  ASSERT_EQ(responder_->max_held_, 4u);
+
+  ASSERT_EQ(responses.size(), requests.size());
+  for (uint8_t i = 0; i < 24; i++) {
+    ASSERT_EQ(responses[i].data[3], i);   // in request order
+  }
+  ASSERT_FALSE(sender_->getIsSending());
+}
+
+TEST_F(CanSenderTest, retriesUnansweredRequests)
+{
+  responder_->mode_ = SdoResponder::kDropFirst;
+  std::vector<Frame> requests = {makeRequest(0x2050, 0), makeRequest(0x6075, 0)};
+
+  std::vector<Frame> responses;
+  ASSERT_FALSE(sender_->sendSdos(requests, &responses, 2, 20000, 0));
+  ASSERT_EQ(responses[0].id, 0u);     // never answered
+  ASSERT_EQ(responses[1].id, 0u);
+
+  requests = {makeRequest(0x2054, 0), makeRequest(0x2055, 1)};
+  ASSERT_TRUE(sender_->sendSdos(requests, &responses, 2, 20000, 1));
+  ASSERT_EQ(responses[1].data[1], 0x55);
+}
+
+TEST_F(CanSenderTest, passesTransmitPdosToController)
+{
+  Frame pdo = {};
+  pdo.id  = kPdo1Transmit + kNode;
+  pdo.len = 6;
+  peer_->send(pdo);
+  pdo.id  = kPdo2Transmit + kNode;
+  peer_->send(pdo);
+
+  uint64_t start = utils::Timer::getTimeMicros();
+  while (controller_.pdos_ < 2 && utils::Timer::getTimeMicros() - start < 1000000) {
+    Thread::sleep(1);
+  }
+  ASSERT_EQ(controller_.pdos_, 2u);
+  ASSERT_EQ(controller_.responses_, 0u);
+}
+
+}}  // namespace hyped::motor_control
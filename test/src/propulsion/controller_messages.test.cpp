@@ -0,0 +1,82 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that the generated controller message tables match the text files
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <string.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "propulsion/controller_messages.hpp"
+#include "propulsion/file_reader.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+static const char kMessageDirectory[] = "data/in/controllerConfigFiles/";
+
+/**
+ * @brief The table must hold exactly the messages FileReader reads from file
+ */
+template<int N>
+static void expectMatchesFile(const ControllerMessage (&table)[N], const char* file)
+{
+  SCOPED_TRACE(file);
+  ControllerMessage read[N] = {};
+  std::string path = std::string(kMessageDirectory) + file;
+  // fails unless the file holds exactly N messages
+  ASSERT_TRUE(FileReader::readFileData(read, N, path.c_str()));
+
+  for (int i = 0; i < N; i++) {
+    ASSERT_EQ(table[i].len, read[i].len);
+    ASSERT_EQ(memcmp(table[i].message_data, read[i].message_data, 8), 0) << "message " << i;
+    ASSERT_STREQ(table[i].logger_output, read[i].logger_output);
+  }
+}
+
+TEST(ControllerMessages, tablesMatchFiles)
+{
+  expectMatchesFile(messages::kConfigure, "configure.txt");
+  expectMatchesFile(messages::kEnterOperational, "enter_operational.txt");
+  expectMatchesFile(messages::kEnterPreOperational, "enter_preOperational.txt");
+  expectMatchesFile(messages::kCheckState, "check_state.txt");
+  expectMatchesFile(messages::kSendTargetVelocity, "send_target_velocity.txt");
+  expectMatchesFile(messages::kSendTargetTorque, "send_target_torque.txt");
+  expectMatchesFile(messages::kUpdateActualVelocity, "update_actual_velocity.txt");
+  expectMatchesFile(messages::kUpdateActualTorque, "update_actual_torque.txt");
+  expectMatchesFile(messages::kQuickStop, "quick_stop.txt");
+  expectMatchesFile(messages::kHealthCheck, "health_check.txt");
+  expectMatchesFile(messages::kUpdateMotorTemp, "update_motor_temp.txt");
+  expectMatchesFile(messages::kUpdateContrTemp, "update_contr_temp.txt");
+  expectMatchesFile(messages::kAutoAlign, "auto_align.txt");
+}
+
+TEST(ControllerMessages, shortFileIsRejected)
+{
+  // a file with fewer messages than expected would leave the rest of the array unset
+  constexpr int kExpected = sizeof(messages::kConfigure) / sizeof(ControllerMessage) + 1;
+  ControllerMessage read[kExpected] = {};
+  std::string path = std::string(kMessageDirectory) + "configure.txt";
+  ASSERT_FALSE(FileReader::readFileData(read, kExpected, path.c_str()));
+}
+
+TEST(ControllerMessages, negativeBytesInTwosComplement)
+{
+  // modes of operation -4 selects auto alignment
+  ASSERT_EQ(messages::kAutoAlign[0].message_data[4], 0xFC);
+}
+
+}}  // namespace hyped::motor_control
@@ -0,0 +1,112 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests the prediction and limits of the battery current budget
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "propulsion/RPM_regulator.hpp"
+#include "propulsion/current_budget.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+class CurrentBudgetTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kBmsPeriod   = 250000;    // microseconds between reports
+  static constexpr double   kOpenCircuit = 125;       // V
+  static constexpr double   kResistance  = 0.04;      // ohm
+
+  /**
+   * @brief Report every pack drawing current A from an ideal source behind kResistance
+   */
+  void report(double current, int temperature = 30, uint16_t low_cell = 0)
+  {
+    data::Batteries batteries = {};
+    for (data::BatteryData& battery : batteries.high_power_batteries) {
+      battery.voltage             = (kOpenCircuit - current * kResistance) * 10;
+      battery.current             = current * 10;
+      battery.average_temperature = temperature;
+      battery.high_temperature    = temperature;
+      battery.low_voltage_cell    = low_cell;
+    }
+    time_ += kBmsPeriod;
+    budget_.update(batteries, time_);
+  }
+
+  CurrentBudget budget_;
+  uint64_t      time_ = 0;
+};
+
+constexpr uint64_t CurrentBudgetTest::kBmsPeriod;
+constexpr double   CurrentBudgetTest::kOpenCircuit;
+constexpr double   CurrentBudgetTest::kResistance;
+
+TEST_F(CurrentBudgetTest, estimatesPackResistance)
+{
+  ASSERT_EQ(budget_.getResistance(0), CurrentBudget::kDefaultResistance);
+  for (int i = 0; i < 40; i++) report(i % 2 ? 50 : 150);
+  ASSERT_NEAR(budget_.getResistance(0), kResistance, 0.002);
+  ASSERT_NEAR(budget_.getResistance(1), kResistance, 0.002);
+}
+
+TEST_F(CurrentBudgetTest, predictsRisingCurrentBeforeNextReport)
+{
+  for (int i = 1; i <= 5; i++) report(40 * i);
+  ASSERT_GT(budget_.getPredictedCurrent(), 200 * 10);
+
+  // a current falling again is not extrapolated below what was reported
+  report(150);
+  report(100);
+  ASSERT_GE(budget_.getPredictedCurrent(), 100 * 10);
+}
+
+TEST_F(CurrentBudgetTest, capsTargetsBeforeLimitIsReached)
+{
+  double max_step = RPM_Regulator::kMaxRpmRate * RPM_Regulator::kPeriod / 1e6;
+  report(0);
+  ASSERT_EQ(budget_.getMaxRpm(3000), 3000 + max_step);
+
+  // still below the limit, but rising fast enough to cross it before the next report
+  for (int i = 1; i <= 6; i++) report(50 * i);
+  ASSERT_LT(300, CurrentBudget::kMaxPackCurrent);
+  ASSERT_LT(budget_.getMaxRpm(3000), 3000);
+  ASSERT_GE(budget_.getMaxRpm(3000), 3000 - max_step);
+}
+
+TEST_F(CurrentBudgetTest, keepsPackAndCellsAboveMinimumVoltage)
+{
+  report(100);
+  double limit = budget_.getCurrentLimit() / 10.0;
+  ASSERT_LE(limit, CurrentBudget::kMaxPackCurrent * (1 - CurrentBudget::kMargin));
+
+  // a weak cell near its minimum leaves less to draw than the pack voltage would
+  report(100, 30, 3100);
+  double cell_limit = budget_.getCurrentLimit() / 10.0;
+  ASSERT_LT(cell_limit, limit);
+  double cell_resistance = budget_.getResistance(0) / data::BatteryData::kNumCells;
+  ASSERT_NEAR(3.1 - (cell_limit - 100) * cell_resistance, CurrentBudget::kMinCellVoltage, 0.01);
+}
+
+TEST_F(CurrentBudgetTest, hotPacksGetLess)
+{
+  report(100, 30);
+  int32_t cool = budget_.getCurrentLimit();
+  report(100, CurrentBudget::kMaxPackTemperature - CurrentBudget::kTemperatureBand / 2);
+  ASSERT_NEAR(budget_.getCurrentLimit(), cool / 2, 1);
+  report(100, CurrentBudget::kMaxPackTemperature);
+  ASSERT_EQ(budget_.getCurrentLimit(), 0);
+}
+
+}}  // namespace hyped::motor_control
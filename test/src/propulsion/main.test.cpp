@@ -0,0 +1,195 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that the propulsion main loop sleeps between state transitions and ticks
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pthread.h>
+#include <time.h>
+
+#include <atomic>
+
+#include "data/data.hpp"
+#include "gtest/gtest.h"
+#include "propulsion/main.hpp"
+#include "utils/clock.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+/**
+ * @brief Propulsion loop that makes its CPU time readable from the test thread
+ */
+class MeasuredMain : public Main {
+ public:
+  MeasuredMain(uint8_t id, Logger& log) : Main(id, log), cpu_clock_known_(false) {}
+
+  void run() override
+  {
+    pthread_getcpuclockid(pthread_self(), &cpu_clock_);
+    cpu_clock_known_ = true;
+    Main::run();
+  }
+
+  std::atomic<bool> cpu_clock_known_;
+  clockid_t         cpu_clock_;
+};
+
+class PropulsionMainTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kMeasureTime = 300;     // milliseconds
+
+  PropulsionMainTest() : log_(false, -1), sys_(utils::System::getSystem()),
+                         data_(data::Data::getInstance()), main_(nullptr), clock_(nullptr) {}
+
+  void SetUp() override
+  {
+    // fake controllers keep the state processor off the CAN bus
+    fake_motors_      = sys_.fake_motors;
+    sys_.fake_motors  = true;
+    sys_.running_     = true;
+    setState(data::State::kIdle);
+
+    // the current budget holds the motors back without healthy packs
+    data::Batteries batteries;
+    for (data::BatteryData& battery : batteries.high_power_batteries) {
+      battery.voltage             = 1250;   // dV
+      battery.average_temperature = 30;
+      battery.high_temperature    = 30;
+    }
+    data_.setBatteriesData(batteries);
+  }
+
+  void TearDown() override
+  {
+    sys_.running_ = false;
+    if (main_) {
+      main_->join();
+      delete main_;
+    }
+    if (clock_) {
+      clock_->detach();
+      clock_->uninstall();
+      delete clock_;
+    }
+    setState(data::State::kIdle);
+    data_.setMotorData(data::Motors());
+    data_.setBatteriesData(data::Batteries());
+    sys_.running_    = true;
+    sys_.fake_motors = fake_motors_;
+  }
+
+  /**
+   * @param simulate - run the loop and the test thread in virtual time, so that what the test
+   *                   measures does not depend on the load of the machine
+   */
+  void startMain(bool simulate)
+  {
+    if (simulate) {
+      clock_ = new utils::SimulationClock(1000000);
+      clock_->install();
+      clock_->attach();
+    }
+    main_ = new MeasuredMain(2, log_);
+    main_->start();
+  }
+
+  void setState(data::State state)
+  {
+    data::StateMachine sm_data = data_.getStateMachineData();
+    sm_data.current_state = state;
+    data_.setStateMachineData(sm_data);
+  }
+
+  uint64_t getCpuMicros()
+  {
+    timespec time;
+    clock_gettime(main_->cpu_clock_, &time);
+    return time.tv_sec * 1000000ull + time.tv_nsec / 1000;
+  }
+
+  /**
+   * @return share of one core the propulsion loop used while the test thread slept, other
+   *         threads of the process do not count
+   */
+  double measureLoad()
+  {
+    while (!main_->cpu_clock_known_) utils::concurrent::Thread::yield();
+    uint64_t cpu  = getCpuMicros();
+    uint64_t wall = utils::Timer::getTimeMicros();
+    utils::concurrent::Thread::sleep(kMeasureTime);
+    return static_cast<double>(getCpuMicros() - cpu) / (utils::Timer::getTimeMicros() - wall);
+  }
+
+  /**
+   * @return microseconds until the motors reported ready, or 0 if they did not within a second
+   */
+  uint64_t waitForReady()
+  {
+    uint64_t start = utils::Timer::getTimeMicros();
+    while (utils::Timer::getTimeMicros() - start < 1000000) {
+      if (data_.getMotorData().module_status == data::ModuleStatus::kReady) {
+        return utils::Timer::getTimeMicros() - start;
+      }
+      utils::concurrent::Thread::sleep(1);
+    }
+    return 0;
+  }
+
+  Logger                  log_;
+  utils::System&          sys_;
+  data::Data&             data_;
+  MeasuredMain*           main_;
+  utils::SimulationClock* clock_;
+  bool                    fake_motors_;
+};
+
+constexpr uint32_t PropulsionMainTest::kMeasureTime;
+
+TEST_F(PropulsionMainTest, sleepsWhileWaitingForTransition)
+{
+  startMain(false);
+  ASSERT_LT(measureLoad(), 0.05);
+}
+
+TEST_F(PropulsionMainTest, wakesOnTransition)
+{
+  startMain(true);
+  // the loop has just gone to sleep, its idle timeout would wake it 100 ms later
+  utils::concurrent::Thread::sleep(10);
+  setState(data::State::kCalibrating);
+  uint64_t latency = waitForReady();
+  ASSERT_GT(latency, 0u);
+  ASSERT_LT(latency, 50000u);
+}
+
+TEST_F(PropulsionMainTest, ticksWhileAccelerating)
+{
+  startMain(false);
+  setState(data::State::kCalibrating);
+  ASSERT_GT(waitForReady(), 0u);
+  setState(data::State::kReady);
+  utils::concurrent::Thread::sleep(10);
+  setState(data::State::kAccelerating);
+
+  ASSERT_LT(measureLoad(), 0.25);
+
+  // the fake controllers follow the regulator, so the loop has been running it
+  for (uint32_t rpm : data_.getMotorData().rpms) ASSERT_GT(rpm, 0u);
+}
+
+}}  // namespace hyped::motor_control
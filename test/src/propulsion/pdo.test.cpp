@@ -0,0 +1,115 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests the transmit PDO mapping and that Controller reads its values from PDOs
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "propulsion/can/pdo.hpp"
+#include "propulsion/controller.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+using utils::io::can::Frame;
+
+static uint32_t getValue(const Frame& request)
+{
+  return request.data[4] | (request.data[5] << 8) | (request.data[6] << 16)
+       | (static_cast<uint32_t>(request.data[7]) << 24);
+}
+
+static uint16_t getIndex(const Frame& request)
+{
+  return request.data[1] | (request.data[2] << 8);
+}
+
+TEST(Pdo, configurationRemapsDisabledPdos)
+{
+  constexpr uint8_t kNode = 2;
+  std::vector<Frame> requests;
+  pdo::getConfiguration(kNode, 10, &requests);
+
+  // every mapping is disabled, remapped and enabled again
+  ASSERT_EQ(requests.size(), 16u);
+  for (const Frame& request : requests) {
+    ASSERT_EQ(request.id, kSdoReceive + kNode);
+  }
+  ASSERT_EQ(getIndex(requests[0]), 0x1800);
+  ASSERT_EQ(getValue(requests[0]), pdo::kCobIdInvalid | (kPdo1Transmit + kNode));
+  ASSERT_EQ(getValue(requests[2]), 10u);                    // event timer
+  ASSERT_EQ(getIndex(requests[4]), 0x1A00);
+  ASSERT_EQ(requests[4].data[3], 1);
+  ASSERT_EQ(getValue(requests[4]), 0x606C0020u);
+  ASSERT_EQ(getValue(requests[6]), 2u);                     // number of mapped objects
+  ASSERT_EQ(getValue(requests[7]), kPdo1Transmit + kNode);
+
+  ASSERT_EQ(getIndex(requests[8]), 0x1801);
+  ASSERT_EQ(getValue(requests[10]), 100u);
+  ASSERT_EQ(getValue(requests[15]), kPdo2Transmit + kNode);
+}
+
+TEST(Pdo, ignoresShortAndUnknownPdos)
+{
+  Frame message = {};
+  message.id  = kPdo1Transmit + 1;
+  message.len = 6;
+  ASSERT_EQ(pdo::getMapping(message, 1), 0);
+  ASSERT_EQ(pdo::getMapping(message, 2), -1);
+  message.len = 4;
+  ASSERT_EQ(pdo::getMapping(message, 1), -1);
+  message.id  = kPdo3Transmit + 1;
+  message.len = 8;
+  ASSERT_EQ(pdo::getMapping(message, 1), -1);
+}
+
+TEST(Pdo, controllerDecodesActualValues)
+{
+  utils::Logger log(false, -1);
+  Controller controller(log, 1);
+
+  // -1500 rpm and -20 per mille of rated torque
+  Frame actual = {};
+  actual.id  = kPdo1Transmit + 1;
+  actual.len = 6;
+  uint8_t actual_data[] = {0x24, 0xFA, 0xFF, 0xFF, 0xEC, 0xFF};
+  std::copy(actual_data, actual_data + 6, actual.data);
+  controller.processPdoMessage(actual);
+  ASSERT_EQ(controller.getVelocity(), -1500);
+  ASSERT_EQ(controller.getTorque(), -20);
+
+  Frame temperatures = {};
+  temperatures.id      = kPdo2Transmit + 1;
+  temperatures.len     = 2;
+  temperatures.data[0] = 200;
+  temperatures.data[1] = 45;
+  controller.processPdoMessage(temperatures);
+  ASSERT_EQ(controller.getMotorTemp(), 200);
+  ASSERT_EQ(controller.getControllerTemp(), 45);
+
+  // streamed values are not requested, a request would time out without a bus
+  uint64_t start = utils::Timer::getTimeMicros();
+  controller.updateActualVelocity();
+  controller.updateActualTorque();
+  controller.updateMotorTemp();
+  controller.updateControllerTemp();
+  ASSERT_LT(utils::Timer::getTimeMicros() - start, 1000u);
+  ASSERT_FALSE(controller.getFailure());
+}
+
+}}  // namespace hyped::motor_control
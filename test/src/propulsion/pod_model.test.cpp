@@ -0,0 +1,203 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests the pod physics model and runs RPM_Regulator through a simulated run
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "propulsion/RPM_regulator.hpp"
+#include "propulsion/current_budget.hpp"
+#include "propulsion/fake_controller.hpp"
+#include "propulsion/pod_model.hpp"
+#include "utils/clock.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+class PodModelTest : public ::testing::Test {
+ protected:
+  static constexpr double kTrackLength = 1250;    // m
+  static constexpr double kMargin      = 50;      // m left when the brakes stopped the pod
+  static constexpr int    kBmsPeriod   = 50;      // control periods between battery reports
+
+  PodModelTest() : log_(false, -1), model_(clock_)
+  {
+    for (int i = 0; i < PodModel::kNumMotors; i++) {
+      motors_.emplace_back(new FakeController(log_, i, false, &model_));
+    }
+  }
+
+  int32_t getAverageRpm()
+  {
+    int32_t total = 0;
+    for (auto& motor : motors_) total += motor->getVelocity();
+    return total / PodModel::kNumMotors;
+  }
+
+  struct Run {
+    double    max_velocity;
+    double    distance;
+    uint64_t  time;           // microseconds of simulated time
+    uint8_t   max_temp;
+    double    max_current;    // A of one pack
+    double    min_voltage;    // V
+  };
+
+  /**
+   * @brief The batteries as the BMS reports them, every pack carries its share of the current
+   */
+  data::Batteries getBatteries()
+  {
+    data::Batteries batteries = {};
+    for (data::BatteryData& battery : batteries.high_power_batteries) {
+      battery.voltage = model_.getBatteryVoltage() * 10;
+      battery.current = model_.getBatteryCurrent() * 10 / data::Batteries::kNumHPBatteries;
+      battery.average_temperature = PodModel::kAmbient;
+      battery.high_temperature    = PodModel::kAmbient;
+    }
+    return batteries;
+  }
+
+  /**
+   * @brief Accelerate with the regulator until the brakes have to be applied to stop kMargin
+   * before the end of the track, then brake to a standstill
+   */
+  Run simulateRun(RPM_Regulator* regulator, CurrentBudget* budget = nullptr)
+  {
+    Run run = {0, 0, 0, 0, 0, PodModel::kOpenCircuitVoltage};
+    uint64_t start = clock_.getTimeMicros();
+    data::Batteries reported = getBatteries();
+    regulator->reset(0);
+    for (int cycle = 0; ; cycle++) {
+      clock_.advance(RPM_Regulator::kPeriod);
+      double velocity = model_.getVelocity();
+      double braking  = velocity * velocity / (2 * PodModel::kBrakeDeceleration);
+      if (model_.getDistance() + braking >= kTrackLength - kMargin) break;
+
+      double pack_current = model_.getBatteryCurrent() / data::Batteries::kNumHPBatteries;
+      run.max_current = std::max(run.max_current, pack_current);
+      run.min_voltage = std::min(run.min_voltage, model_.getBatteryVoltage());
+      if (cycle % kBmsPeriod == 0) reported = getBatteries();
+
+      int32_t current = reported.high_power_batteries[0].current;
+      if (budget) {
+        budget->update(reported, clock_.getTimeMicros());
+        regulator->setCurrentLimit(budget->getCurrentLimit());
+        current = budget->getPredictedCurrent();
+      }
+      int32_t rpm = regulator->calculateRPM(velocity, getAverageRpm(), current,
+                                            motors_[0]->getMotorTemp());
+      for (auto& motor : motors_) {
+        int32_t target = rpm;
+        if (budget) target = std::min(rpm, budget->getMaxRpm(motor->getVelocity()));
+        motor->sendTargetVelocity(target);
+      }
+      run.max_velocity = std::max(run.max_velocity, velocity);
+    }
+
+    for (auto& motor : motors_) motor->enterPreOperational();
+    model_.setBrakes(true);
+    while (model_.getVelocity() > 0) clock_.advance(RPM_Regulator::kPeriod);
+
+    run.distance = model_.getDistance();
+    run.time     = clock_.getTimeMicros() - start;
+    run.max_temp = motors_[0]->getMotorTemp();
+    return run;
+  }
+
+  utils::ManualClock                            clock_;
+  Logger                                        log_;
+  PodModel                                      model_;
+  std::vector<std::unique_ptr<FakeController>>  motors_;
+};
+
+constexpr double PodModelTest::kTrackLength;
+constexpr double PodModelTest::kMargin;
+constexpr int    PodModelTest::kBmsPeriod;
+
+TEST_F(PodModelTest, standsStillUntilDriven)
+{
+  clock_.advance(1000000);
+  ASSERT_EQ(model_.getVelocity(), 0);
+  ASSERT_EQ(model_.getRpm(0), 0);
+  ASSERT_EQ(model_.getBatteryVoltage(), PodModel::kOpenCircuitVoltage);
+}
+
+TEST_F(PodModelTest, rotorAccelerationLimitedByStallTorque)
+{
+  motors_[0]->sendTargetVelocity(6000);
+  clock_.advance(10000);
+
+  // the pod barely moves yet, so the rotor at most gets the full stall torque
+  double max_rpm = PodModel::kStallTorque / PodModel::kRotorInertia * 0.01 * 60 / (2 * M_PI);
+  ASSERT_GT(motors_[0]->getVelocity(), 0);
+  ASSERT_LE(motors_[0]->getVelocity(), max_rpm + 1);
+  ASSERT_EQ(motors_[1]->getVelocity(), 0);
+  ASSERT_LT(model_.getBatteryVoltage(), PodModel::kOpenCircuitVoltage);
+}
+
+TEST_F(PodModelTest, publishesBatteryLoad)
+{
+  model_.setPublishBatteries(true);
+  for (auto& motor : motors_) motor->sendTargetVelocity(3000);
+  clock_.advance(100000);
+  model_.update();
+
+  data::Batteries batteries = data::Data::getInstance().getBatteriesData();
+  for (data::BatteryData& battery : batteries.high_power_batteries) {
+    ASSERT_GT(battery.current, 0);
+    ASSERT_LT(battery.voltage, PodModel::kOpenCircuitVoltage * 10);
+  }
+  model_.setPublishBatteries(false);
+}
+
+TEST_F(PodModelTest, simulatesFullRunFasterThanRealTime)
+{
+  RPM_Regulator regulator(log_);
+  uint64_t start = utils::Timer::getTimeMicros();
+  Run run = simulateRun(&regulator);
+  uint64_t elapsed = utils::Timer::getTimeMicros() - start;
+
+  ASSERT_LT(run.distance, kTrackLength);
+  ASSERT_GT(run.distance, kTrackLength - 2 * kMargin);
+  ASSERT_GT(run.max_velocity, 25);
+  ASSERT_LT(run.max_temp, MAX_TEMP);
+  ASSERT_LT(elapsed, 1000000u);
+  RecordProperty("simulated_ms", static_cast<int>(run.time / 1000));
+  RecordProperty("wall_time_ms", static_cast<int>(elapsed / 1000));
+}
+
+TEST_F(PodModelTest, currentBudgetSustainsAccelerationWithinBmsLimits)
+{
+  RPM_Regulator regulator(log_);
+  CurrentBudget budget;
+  Run run = simulateRun(&regulator, &budget);
+
+  // what BmsManager::batteriesInRange checks, in the units of the BMS reports
+  int max_current = data::Batteries::kMaxHPCurrent;
+  int min_voltage = data::Batteries::kMinHPVoltage;
+  ASSERT_LT(run.max_current * 10, max_current);
+  ASSERT_GT(run.min_voltage * 10, min_voltage);
+  ASSERT_LT(run.distance, kTrackLength);
+
+  // simulatesFullRunFasterThanRealTime, held back by the fixed kMaxCurrent, reaches about 32 m/s
+  ASSERT_GT(run.max_velocity, 40);
+}
+
+}}  // namespace hyped::motor_control
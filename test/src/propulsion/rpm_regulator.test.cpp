@@ -0,0 +1,121 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests the fixed-rate speed control of RPM_Regulator against FakeController
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "propulsion/RPM_regulator.hpp"
+#include "propulsion/fake_controller.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+class RpmRegulatorTest : public ::testing::Test {
+ protected:
+  RpmRegulatorTest() : log_(false, -1), regulator_(log_), motor_(log_, 0, false) {}
+
+  /**
+   * @brief Run the regulator for steps control periods with the motor following its target
+   * @return targets sent to the motor
+   */
+  std::vector<int32_t> run(int steps, float velocity, int32_t current, int32_t temp)
+  {
+    std::vector<int32_t> targets;
+    for (int i = 0; i < steps; i++) {
+      int32_t rpm = regulator_.calculateRPM(velocity, motor_.getVelocity(), current, temp);
+      motor_.sendTargetVelocity(rpm);
+      targets.push_back(rpm);
+    }
+    return targets;
+  }
+
+  static constexpr int32_t kTemp    = 60;
+  static constexpr int     kPerSecond = 1000000 / RPM_Regulator::kPeriod;
+
+  Logger          log_;
+  RPM_Regulator   regulator_;
+  FakeController  motor_;
+};
+
+constexpr int32_t RpmRegulatorTest::kTemp;
+constexpr int     RpmRegulatorTest::kPerSecond;
+
+TEST_F(RpmRegulatorTest, lookupTableFollowsPolynomial)
+{
+  ASSERT_NEAR(regulator_.getOptimalRPM(0), 1024.3, 0.1);
+  ASSERT_NEAR(regulator_.getOptimalRPM(10), 4033.6, 0.1);
+  ASSERT_NEAR(regulator_.getOptimalRPM(10.25), 4033.6 + 0.25 * 297.73 + 0.32 * 5.06, 0.1);
+  ASSERT_EQ(regulator_.getOptimalRPM(-1), regulator_.getOptimalRPM(0));
+  ASSERT_EQ(regulator_.getOptimalRPM(1000), MAX_RPM);
+}
+
+TEST_F(RpmRegulatorTest, stepResponseSettlesWithoutOvershoot)
+{
+  double optimal = regulator_.getOptimalRPM(10);
+  std::vector<int32_t> targets = run(2 * kPerSecond, 10, 0, kTemp);
+
+  // the reference rises at kMaxRpmRate, the target may not get far ahead of it
+  double max_step = RPM_Regulator::kMaxRpmRate * RPM_Regulator::kPeriod / 1e6;
+  for (size_t i = 1; i < targets.size(); i++) {
+    ASSERT_LE(targets[i] - targets[i - 1], 2 * max_step);
+    ASSERT_LE(targets[i], optimal * 1.02);
+  }
+  int rise = optimal / RPM_Regulator::kMaxRpmRate * kPerSecond;
+  ASSERT_NEAR(targets[rise + kPerSecond / 5], optimal, optimal * 0.01);
+  ASSERT_NEAR(targets.back(), optimal, 1);
+}
+
+TEST_F(RpmRegulatorTest, currentAndTemperatureAreSoftLimits)
+{
+  run(2 * kPerSecond, 10, 0, kTemp);
+  int32_t cruising = motor_.getVelocity();
+
+  // at the limit the target holds, beyond it falls at most as fast as it may rise
+  std::vector<int32_t> targets = run(kPerSecond / 10, 20, RPM_Regulator::kMaxCurrent, kTemp);
+  ASSERT_EQ(targets.back(), cruising);
+  targets = run(kPerSecond / 10, 20,
+                RPM_Regulator::kMaxCurrent * (1 + RPM_Regulator::kCurrentBand), kTemp);
+  ASSERT_LT(targets.back(), cruising);
+  ASSERT_GE(targets.back(), cruising - RPM_Regulator::kMaxRpmRate / 10 - 1);
+
+  cruising = motor_.getVelocity();
+  targets  = run(kPerSecond / 10, 20, 0, MAX_TEMP + 5);
+  ASSERT_LT(targets.back(), cruising);
+
+  // once within the limits again the target rises without the integral having wound up
+  targets = run(2 * kPerSecond, 20, 0, kTemp);
+  double optimal = regulator_.getOptimalRPM(20);
+  for (int32_t target : targets) ASSERT_LE(target, optimal * 1.02);
+  ASSERT_NEAR(targets.back(), optimal, 1);
+}
+
+TEST_F(RpmRegulatorTest, replaysExactly)
+{
+  RPM_Regulator other(log_);
+  FakeController other_motor(log_, 1, false);
+  for (int i = 0; i < kPerSecond; i++) {
+    float   velocity = i * 0.02;
+    int32_t current  = (i % 50) * 40;
+    int32_t rpm      = regulator_.calculateRPM(velocity, motor_.getVelocity(), current, kTemp);
+    int32_t replayed = other.calculateRPM(velocity, other_motor.getVelocity(), current, kTemp);
+    ASSERT_EQ(rpm, replayed);
+    motor_.sendTargetVelocity(rpm);
+    other_motor.sendTargetVelocity(replayed);
+  }
+}
+
+}}  // namespace hyped::motor_control
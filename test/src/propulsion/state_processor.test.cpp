@@ -0,0 +1,210 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that StateProcessor brings all controllers up and down concurrently
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "propulsion/controller_interface.hpp"
+#include "propulsion/fake_controller.hpp"
+#include "propulsion/state_processor.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace motor_control {
+
+using utils::concurrent::Thread;
+
+/**
+ * @brief Takes kDelay milliseconds for every phase, like a controller waiting on its SDOs
+ */
+class SlowController : public ControllerInterface {
+ public:
+  static constexpr uint32_t kDelay = 100;
+
+  explicit SlowController(bool faulty)
+      : single_reads_(0), combined_reads_(0), faulty_(faulty), state_(kSwitchOnDisabled) {}
+
+  void configure() override { Thread::sleep(kDelay); }
+  void enterOperational() override
+  {
+    Thread::sleep(kDelay);
+    state_ = kOperationEnabled;
+  }
+  void enterPreOperational() override
+  {
+    Thread::sleep(kDelay);
+    state_ = kSwitchOnDisabled;
+  }
+  bool getFailure() override { return faulty_; }
+  ControllerState getControllerState() override { return state_; }
+
+  void registerController() override {}
+  void checkState() override {}
+  void sendTargetVelocity(int32_t target_velocity) override {}
+  void updateActualVelocity() override { single_reads_++; }
+  int32_t getVelocity() override { return 1000; }
+  void quickStop() override {}
+  void healthCheck() override {}
+  void updateMotorTemp() override { single_reads_++; }
+  uint8_t getMotorTemp() override { return 40; }
+  void updateActualValues() override { combined_reads_++; }
+  void processEmergencyMessage(utils::io::can::Frame& message) override {}
+  void processErrorMessage(uint16_t error_message) override {}
+  void processSdoMessage(utils::io::can::Frame& message) override {}
+  void processNmtMessage(utils::io::can::Frame& message) override {}
+  void processPdoMessage(utils::io::can::Frame& message) override {}
+  void requestStateTransition(utils::io::can::Frame& message, ControllerState state) override
+  {}
+
+  int single_reads_;      // actual velocity or temperature requested on its own
+  int combined_reads_;    // both requested in one exchange
+
+ private:
+  bool            faulty_;
+  ControllerState state_;
+};
+
+/**
+ * @brief Gives the tests access to the controllers and the phases
+ */
+class TestStateProcessor : public StateProcessor {
+ public:
+  TestStateProcessor(int motor_amount, int faulty)
+      : StateProcessor(motor_amount, utils::System::getLogger())
+  {
+    for (int i = 0; i < motor_amount; i++) {
+      delete controllers[i];
+      controllers[i] = new SlowController(i == faulty);
+    }
+  }
+
+  ~TestStateProcessor()
+  {
+    for (int i = 0; i < motorAmount; i++) delete controllers[i];
+    delete[] controllers;
+  }
+
+  using StateProcessor::configureControllers;
+  using StateProcessor::prepareMotors;
+  using StateProcessor::runOnAllControllers;
+  using StateProcessor::takeSnapshot;
+
+  ControllerState getState(int i) { return controllers[i]->getControllerState(); }
+  SlowController* getController(int i) { return static_cast<SlowController*>(controllers[i]); }
+  void setInitialized() { initialized = true; }
+};
+
+class StateProcessorTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    // fake controllers keep the constructor off the CAN bus
+    fake_motors_ = utils::System::getSystem().fake_motors;
+    utils::System::getSystem().fake_motors = true;
+  }
+
+  void TearDown() override
+  {
+    utils::System::getSystem().fake_motors = fake_motors_;
+  }
+
+  static uint64_t timePhase(TestStateProcessor* processor, StateProcessor::Phase phase)
+  {
+    uint64_t start = utils::Timer::getTimeMicros();
+    processor->runOnAllControllers(phase);
+    return utils::Timer::getTimeMicros() - start;
+  }
+
+  bool fake_motors_;
+};
+
+TEST_F(StateProcessorTest, phaseTimeDoesNotGrowWithMotors)
+{
+  TestStateProcessor two(2, -1);
+  TestStateProcessor eight(8, -1);
+  uint64_t time_two   = timePhase(&two, &ControllerInterface::configure);
+  uint64_t time_eight = timePhase(&eight, &ControllerInterface::configure);
+
+  ASSERT_GE(time_eight, SlowController::kDelay * 1000);
+  ASSERT_LT(time_eight, 2 * SlowController::kDelay * 1000);   // sequential would take 8x
+  ASSERT_LT(time_eight, time_two + SlowController::kDelay * 1000);
+}
+
+TEST_F(StateProcessorTest, allControllersFinishBeforeReturning)
+{
+  TestStateProcessor processor(4, -1);
+  processor.prepareMotors();
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(processor.getState(i), kOperationEnabled);
+  }
+  processor.enterPreOperational();
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(processor.getState(i), kSwitchOnDisabled);
+  }
+}
+
+TEST_F(StateProcessorTest, combinesFailures)
+{
+  TestStateProcessor healthy(4, -1);
+  ASSERT_TRUE(healthy.runOnAllControllers(&ControllerInterface::configure));
+
+  TestStateProcessor faulty(4, 2);
+  ASSERT_FALSE(faulty.runOnAllControllers(&ControllerInterface::configure));
+}
+
+TEST_F(StateProcessorTest, snapshotReadsEveryInputOnce)
+{
+  data::Data& data = data::Data::getInstance();
+  data::Navigation navigation = data.getNavigationData();
+  data::Batteries  batteries  = data.getBatteriesData();
+  data::Navigation moving     = navigation;
+  data::Batteries  loaded     = batteries;
+  moving.velocity = 12;
+  loaded.high_power_batteries[0].current = 300;
+  loaded.high_power_batteries[1].current = 250;
+  data.setNavigationData(moving);
+  data.setBatteriesData(loaded);
+
+  TestStateProcessor processor(4, -1);
+  ControlSnapshot snapshot = processor.takeSnapshot();
+  data.setNavigationData(navigation);
+  data.setBatteriesData(batteries);
+
+  ASSERT_EQ(snapshot.velocity, 12);
+  ASSERT_EQ(snapshot.average_rpm, 1000);
+  ASSERT_EQ(snapshot.max_current, 300);
+  ASSERT_EQ(snapshot.max_temp, 40);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(processor.getController(i)->combined_reads_, 1);
+    ASSERT_EQ(processor.getController(i)->single_reads_, 0);
+  }
+}
+
+TEST_F(StateProcessorTest, accelerateUsesCombinedReads)
+{
+  TestStateProcessor processor(4, -1);
+  processor.prepareMotors();
+  processor.setInitialized();
+  processor.accelerate();
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(processor.getController(i)->combined_reads_, 1);
+    ASSERT_EQ(processor.getController(i)->single_reads_, 0);
+  }
+}
+
+}}  // namespace hyped::motor_control
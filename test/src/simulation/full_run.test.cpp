@@ -0,0 +1,306 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description:
+ * Runs all modules with fake sensors, motors and brakes on a SimulationClock, the test thread in
+ * place of the ground station. A run of the pod takes milliseconds and repeats exactly, so many
+ * randomised scenarios fit in a test. For more, repeat with a new seed each time:
+ *   ./test/testrunner --gtest_filter=FullRunTest.* --gtest_repeat=1000 --gtest_shuffle
+ * and reproduce a failure with the --gtest_random_seed it reports.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <cstdint>
+#include <random>
+
+#include <algorithm>
+#include <vector>
+
+#include "data/data.hpp"
+#include "embrakes/main.hpp"
+#include "gtest/gtest.h"
+#include "navigation/main.hpp"
+#include "propulsion/main.hpp"
+#include "sensors/main.hpp"
+#include "state_machine/main.hpp"
+#include "utils/clock.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/logger.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace simulation {
+
+using utils::concurrent::Thread;
+
+/**
+ * @brief What the ground station and the fakes do during a run
+ */
+struct Scenario {
+  uint32_t  seed            = 0;
+  uint64_t  launch_delay    = 0;        // microseconds in Ready before the launch command
+  uint64_t  emergency_time  = 0;        // microseconds after launch, 0 for none
+  bool      imu_fail        = false;
+  bool      batteries_fail  = false;
+};
+
+struct Transition {
+  data::State state;
+  uint64_t    time;
+
+  bool operator==(const Transition& other) const
+  {
+    return state == other.state && time == other.time;
+  }
+};
+
+struct Result {
+  std::vector<Transition> transitions;
+  bool                    finished      = false;    // shut down before the time limit
+  data::nav_t             displacement  = 0;
+  data::nav_t             max_velocity  = 0;
+  uint64_t                wall_time     = 0;        // microseconds
+  uint64_t                switches      = 0;
+};
+
+class FullRunTest : public ::testing::Test {
+ protected:
+  // several modules take a timestamp of 0 as not set
+  static constexpr uint64_t kStartTime  = 1000000;
+  static constexpr uint64_t kTimeLimit  = 300000000;  // microseconds, ends a run that hangs
+  static constexpr uint64_t kPollPeriod = 10000;      // microseconds between ground station polls
+  static constexpr int      kNumRandomScenarios = 3;
+  static constexpr uint64_t kYieldTime  = 5000;
+
+  FullRunTest() : log_(false, -1), sys_(utils::System::getSystem()),
+                  data_(data::Data::getInstance()) {}
+
+  void SetUp() override
+  {
+    for (int i = 0; i < kNumFakes; i++) {
+      saved_[i]   = sys_.*kFakes[i];
+      sys_.*kFakes[i] = false;
+    }
+    sys_.fake_imu         = true;
+    sys_.fake_batteries   = true;
+    sys_.fake_keyence     = true;
+    sys_.fake_temperature = true;
+    sys_.fake_embrakes    = true;
+    sys_.fake_motors      = true;
+  }
+
+  void TearDown() override
+  {
+    for (int i = 0; i < kNumFakes; i++) sys_.*kFakes[i] = saved_[i];
+    sys_.running_ = true;
+    resetData();
+  }
+
+  void resetData()
+  {
+    data::StateMachine sm_data = {};
+    sm_data.critical_failure   = false;
+    sm_data.current_state      = data::State::kIdle;
+    data_.setStateMachineData(sm_data);
+    data_.setEmergencyBrakesData(data::EmergencyBrakes());
+    data_.setNavigationData(data::Navigation());
+    data_.setBatteriesData(data::Batteries());
+    data_.setTelemetryData(data::Telemetry());
+    data_.setSensorsData(data::Sensors());
+    data_.setMotorData(data::Motors());
+  }
+
+  /**
+   * @return scenario drawn from seed, most of them nominal runs
+   */
+  static Scenario randomScenario(uint32_t seed)
+  {
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    Scenario scenario;
+    scenario.seed           = seed;
+    scenario.launch_delay   = std::uniform_int_distribution<uint64_t>(0, 5000000)(random);
+    scenario.imu_fail       = percent(random) < 10;
+    scenario.batteries_fail = percent(random) < 10;
+    if (percent(random) < 20) {
+      scenario.emergency_time = std::uniform_int_distribution<uint64_t>(1, 30000000)(random);
+    }
+    return scenario;
+  }
+
+  /**
+   * @brief Commands the pod like the ground station would, until it is off
+   */
+  void commandRun(const Scenario& scenario, Result* result)
+  {
+    data::Telemetry telemetry_data = data_.getTelemetryData();
+    telemetry_data.module_status     = data::ModuleStatus::kReady;
+    telemetry_data.calibrate_command = true;
+    data_.setTelemetryData(telemetry_data);
+
+    uint64_t ready_time  = 0;
+    uint64_t launch_time = 0;
+    uint32_t update      = 0;
+    data::State state    = data::State::kIdle;
+    while (sys_.running_ && utils::Timer::getTimeMicros() < kStartTime + kTimeLimit) {
+      update = data_.waitForStateMachineData(update, kPollPeriod);
+      uint64_t now = utils::Timer::getTimeMicros();
+
+      data::State next = data_.getStateMachineData().current_state;
+      if (next != state) {
+        state = next;
+        result->transitions.push_back({state, now - kStartTime});
+        if (state == data::State::kReady) ready_time = now;
+        if (state == data::State::kAccelerating) launch_time = now;
+      }
+      data::Navigation nav_data = data_.getNavigationData();
+      result->max_velocity = std::max(result->max_velocity, nav_data.velocity);
+
+      telemetry_data = data_.getTelemetryData();
+      bool sent = false;
+      if (state == data::State::kReady && !telemetry_data.launch_command
+          && now - ready_time >= scenario.launch_delay) {
+        telemetry_data.launch_command = sent = true;
+      }
+      if (launch_time && scenario.emergency_time && !telemetry_data.emergency_stop_command
+          && now - launch_time >= scenario.emergency_time) {
+        telemetry_data.emergency_stop_command = sent = true;
+      }
+      if ((state == data::State::kFinished || state == data::State::kFailureStopped)
+          && !telemetry_data.shutdown_command) {
+        telemetry_data.shutdown_command = sent = true;
+      }
+      if (sent) data_.setTelemetryData(telemetry_data);
+    }
+    result->finished = !sys_.running_;
+  }
+
+  Result run(const Scenario& scenario)
+  {
+    Result result;
+    sys_.fake_imu_fail       = scenario.imu_fail;
+    sys_.fake_batteries_fail = scenario.batteries_fail;
+    sys_.running_            = true;
+    resetData();
+    srand(scenario.seed);
+
+    uint64_t start = utils::Timer::getTimeMicros();
+    utils::SimulationClock clock(kStartTime, kYieldTime);
+    clock.install();
+    clock.attach();
+
+    Thread* threads[] = {
+      new sensors::Main(0, log_),
+      new embrakes::Main(1, log_),
+      new motor_control::Main(2, log_),
+      new state_machine::Main(4, log_),
+      new navigation::Main(5, log_),
+    };
+    for (Thread* thread : threads) thread->start();
+
+    commandRun(scenario, &result);
+    sys_.running_ = false;
+
+    for (Thread* thread : threads) {
+      thread->join();
+      delete thread;
+    }
+    result.displacement = data_.getNavigationData().displacement;
+    result.switches     = clock.getSwitches();
+
+    clock.detach();
+    clock.uninstall();
+    result.wall_time = utils::Timer::getTimeMicros() - start;
+    return result;
+  }
+
+  /**
+   * @brief Checks what holds for every run
+   */
+  static void checkRun(const Result& result)
+  {
+    ASSERT_TRUE(result.finished);
+    ASSERT_FALSE(result.transitions.empty());
+    // shut down from where the pod stands, which is the end of every run
+    data::State last = result.transitions.back().state;
+    ASSERT_TRUE(last == data::State::kFinished || last == data::State::kFailureStopped);
+    data::nav_t run_length = data::Navigation::kRunLength;
+    ASSERT_LT(result.displacement, run_length);
+  }
+
+  static constexpr int kNumFakes = 10;
+  static constexpr bool utils::System::*kFakes[kNumFakes] = {
+    &utils::System::fake_imu, &utils::System::fake_imu_fail,
+    &utils::System::fake_batteries, &utils::System::fake_batteries_fail,
+    &utils::System::fake_keyence, &utils::System::fake_keyence_fail,
+    &utils::System::fake_temperature, &utils::System::fake_temperature_fail,
+    &utils::System::fake_embrakes, &utils::System::fake_motors
+  };
+
+  utils::Logger         log_;
+  utils::System&        sys_;
+  data::Data&           data_;
+  bool                  saved_[kNumFakes];
+};
+
+constexpr uint64_t FullRunTest::kStartTime;
+constexpr uint64_t FullRunTest::kTimeLimit;
+constexpr uint64_t FullRunTest::kPollPeriod;
+constexpr int      FullRunTest::kNumRandomScenarios;
+constexpr int      FullRunTest::kNumFakes;
+constexpr bool utils::System::*FullRunTest::kFakes[];
+
+TEST_F(FullRunTest, nominalRunStopsBeforeEndOfTrack)
+{
+  Scenario scenario;
+  Result result = run(scenario);
+  RecordProperty("wall_time_ms", static_cast<int>(result.wall_time / 1000));
+  RecordProperty("clock_switches", static_cast<int>(result.switches));
+  checkRun(result);
+
+  std::vector<data::State> states;
+  for (const Transition& transition : result.transitions) states.push_back(transition.state);
+  std::vector<data::State> expected = {
+    data::State::kCalibrating, data::State::kReady, data::State::kAccelerating,
+    data::State::kNominalBraking, data::State::kFinished
+  };
+  if (states.size() > 3 && states[3] == data::State::kCruising) {
+    expected.insert(expected.begin() + 3, data::State::kCruising);
+  }
+  ASSERT_EQ(states, expected);
+  ASSERT_GT(result.max_velocity, 0);
+}
+
+TEST_F(FullRunTest, repeatsExactly)
+{
+  Scenario scenario = randomScenario(42);
+  Result first  = run(scenario);
+  Result second = run(scenario);
+  ASSERT_EQ(first.transitions, second.transitions);
+  ASSERT_EQ(first.displacement, second.displacement);
+  ASSERT_EQ(first.max_velocity, second.max_velocity);
+}
+
+TEST_F(FullRunTest, randomScenariosEndSafely)
+{
+  std::mt19937 seeds(::testing::UnitTest::GetInstance()->random_seed());
+  for (int i = 0; i < kNumRandomScenarios; i++) {
+    Scenario scenario = randomScenario(seeds());
+    SCOPED_TRACE(::testing::Message() << "scenario seed " << scenario.seed);
+    Result result     = run(scenario);
+    checkRun(result);
+  }
+}
+
+}}  // namespace hyped::simulation
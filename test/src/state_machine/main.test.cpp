@@ -0,0 +1,245 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that the state machine thread sleeps until the data it depends on changes
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <pthread.h>
+#include <time.h>
+
+#include <atomic>
+
+#include "data/data.hpp"
+#include "gtest/gtest.h"
+#include "state_machine/main.hpp"
+#include "utils/clock.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace state_machine {
+
+/**
+ * @brief State machine thread that makes its CPU time readable from the test thread
+ */
+class MeasuredMain : public Main {
+ public:
+  MeasuredMain(uint8_t id, Logger& log) : Main(id, log), cpu_clock_known_(false) {}
+
+  void run() override
+  {
+    pthread_getcpuclockid(pthread_self(), &cpu_clock_);
+    cpu_clock_known_ = true;
+    Main::run();
+  }
+
+  std::atomic<bool> cpu_clock_known_;
+  clockid_t         cpu_clock_;
+};
+
+class StateMachineMainTest : public ::testing::Test {
+ protected:
+  static constexpr uint32_t kMeasureTime = 300;     // milliseconds
+
+  StateMachineMainTest() : log_(false, -1), sys_(utils::System::getSystem()),
+                           data_(data::Data::getInstance()), main_(nullptr),
+                           clock_(nullptr) {}
+
+  void SetUp() override
+  {
+    resetData();
+    sys_.running_ = true;
+  }
+
+  void TearDown() override
+  {
+    sys_.running_ = false;
+    if (main_) {
+      main_->join();
+      delete main_;
+    }
+    if (clock_) {
+      clock_->detach();
+      clock_->uninstall();
+      delete clock_;
+    }
+    resetData();
+    sys_.running_ = true;
+  }
+
+  /**
+   * @param simulate - run the state machine and the test thread in virtual time, so that what
+   *                   the test measures does not depend on the load of the machine
+   * @return true once the state machine is in Idle
+   */
+  bool startMain(bool simulate)
+  {
+    if (simulate) {
+      clock_ = new utils::SimulationClock(1000000);
+      clock_->install();
+      clock_->attach();
+    }
+    main_ = new MeasuredMain(3, log_);
+    main_->start();
+    return waitForState(data::State::kIdle);
+  }
+
+  void resetData()
+  {
+    data::StateMachine sm_data = data_.getStateMachineData();
+    sm_data.current_state    = data::State::kIdle;
+    sm_data.critical_failure = false;
+    data_.setStateMachineData(sm_data);
+    data_.setTelemetryData(data::Telemetry());
+    data_.setNavigationData(data::Navigation());
+    setModuleStatus(data::ModuleStatus::kStart);
+    data_.setStateMachineStats(data::StateMachineStats());
+  }
+
+  void setModuleStatus(data::ModuleStatus status)
+  {
+    data::EmergencyBrakes embrakes_data = data_.getEmergencyBrakesData();
+    embrakes_data.module_status         = status;
+    data_.setEmergencyBrakesData(embrakes_data);
+    data::Navigation nav_data = data_.getNavigationData();
+    nav_data.module_status    = status;
+    data_.setNavigationData(nav_data);
+    data::Batteries batteries_data = data_.getBatteriesData();
+    batteries_data.module_status   = status;
+    data_.setBatteriesData(batteries_data);
+    data::Telemetry telemetry_data = data_.getTelemetryData();
+    telemetry_data.module_status   = status;
+    data_.setTelemetryData(telemetry_data);
+    data::Sensors sensors_data = data_.getSensorsData();
+    sensors_data.module_status = status;
+    data_.setSensorsData(sensors_data);
+    data::Motors motors_data  = data_.getMotorData();
+    motors_data.module_status = status;
+    data_.setMotorData(motors_data);
+  }
+
+  /**
+   * @return true once the state machine is in state, false if not within a second
+   */
+  bool waitForState(data::State state)
+  {
+    uint32_t update = 0;
+    uint64_t start  = utils::Timer::getTimeMicros();
+    while (data_.getStateMachineData().current_state != state) {
+      if (utils::Timer::getTimeMicros() - start > 1000000) return false;
+      update = data_.waitForStateMachineData(update, 10000);
+    }
+    return true;
+  }
+
+  /**
+   * @return statistics once they count transitions, the last published if not within a second
+   */
+  data::StateMachineStats waitForTransitions(uint32_t transitions)
+  {
+    data::StateMachineStats stats = data_.getStateMachineStats();
+    for (int i = 0; i < 1000 && stats.transition_latency.getCount() < transitions; i++) {
+      utils::concurrent::Thread::sleep(1);
+      stats = data_.getStateMachineStats();
+    }
+    return stats;
+  }
+
+  uint64_t getCpuMicros()
+  {
+    timespec time;
+    clock_gettime(main_->cpu_clock_, &time);
+    return time.tv_sec * 1000000ull + time.tv_nsec / 1000;
+  }
+
+  /**
+   * @return share of one core the state machine used while the test thread slept, other
+   *         threads of the process do not count
+   */
+  double measureLoad()
+  {
+    while (!main_->cpu_clock_known_) utils::concurrent::Thread::yield();
+    uint64_t cpu  = getCpuMicros();
+    uint64_t wall = utils::Timer::getTimeMicros();
+    utils::concurrent::Thread::sleep(kMeasureTime);
+    return static_cast<double>(getCpuMicros() - cpu) / (utils::Timer::getTimeMicros() - wall);
+  }
+
+  Logger                  log_;
+  utils::System&          sys_;
+  data::Data&             data_;
+  MeasuredMain*           main_;
+  utils::SimulationClock* clock_;
+};
+
+constexpr uint32_t StateMachineMainTest::kMeasureTime;
+
+TEST_F(StateMachineMainTest, sleepsWhileDataIsUnchanged)
+{
+  ASSERT_TRUE(startMain(false));
+  ASSERT_LT(measureLoad(), 0.05);
+}
+
+TEST_F(StateMachineMainTest, wakesOnTelemetryUpdate)
+{
+  ASSERT_TRUE(startMain(true));
+  utils::concurrent::Thread::sleep(10);
+  data::Telemetry telemetry_data = data_.getTelemetryData();
+  telemetry_data.emergency_stop_command = true;
+
+  uint64_t start = utils::Timer::getTimeMicros();
+  data_.setTelemetryData(telemetry_data);
+  ASSERT_TRUE(waitForState(data::State::kFailureStopped));
+  uint64_t latency = utils::Timer::getTimeMicros() - start;
+  ASSERT_LT(latency, Main::kUpdateTimeout / 2);    // woken by the update, not the timeout
+
+  // published with the transition
+  data::StateMachineStats stats = waitForTransitions(1);
+  ASSERT_EQ(stats.transition_latency.getCount(), 1u);
+  ASSERT_LT(stats.transition_latency.getMax(), Main::kUpdateTimeout / 2);
+  ASSERT_GE(stats.tick_time.getCount(), 2u);
+}
+
+TEST_F(StateMachineMainTest, measuresLatencyFromSensorTime)
+{
+  ASSERT_TRUE(startMain(true));
+  setModuleStatus(data::ModuleStatus::kInit);
+  data::Telemetry telemetry_data   = data_.getTelemetryData();
+  telemetry_data.calibrate_command = true;
+  data_.setTelemetryData(telemetry_data);
+  ASSERT_TRUE(waitForState(data::State::kCalibrating));
+  setModuleStatus(data::ModuleStatus::kReady);
+  ASSERT_TRUE(waitForState(data::State::kReady));
+  telemetry_data                = data_.getTelemetryData();
+  telemetry_data.launch_command = true;
+  data_.setTelemetryData(telemetry_data);
+  ASSERT_TRUE(waitForState(data::State::kAccelerating));
+
+  // navigation computed the braking zone from sensor data read 5 ms earlier
+  constexpr uint32_t kSensorAge = 5000;
+  data::Navigation nav_data = data_.getNavigationData();
+  nav_data.displacement     = data::Navigation::kRunLength;
+  nav_data.velocity         = 10;
+  nav_data.timestamp        = utils::Timer::getTimeMicros() - kSensorAge;
+  data_.setNavigationData(nav_data);
+  ASSERT_TRUE(waitForState(data::State::kNominalBraking));
+
+  data::StateMachineStats stats = waitForTransitions(4);
+  ASSERT_EQ(stats.transition_latency.getCount(), 4u);
+  ASSERT_GE(stats.transition_latency.getMax(), kSensorAge);
+  ASSERT_LT(stats.transition_latency.getMax(), kSensorAge + Main::kUpdateTimeout / 2);
+}
+
+}}  // namespace hyped::state_machine
@@ -27,12 +27,14 @@
 #include "gtest/gtest.h"
 #include "randomiser.hpp"
 #include "state_machine/main.hpp"
+#include "utils/clock.hpp"
 #include "utils/concurrent/thread.hpp"
 #include "utils/logger.hpp"
 #include "utils/system.hpp"
 
 using namespace hyped::data;
 using namespace hyped::state_machine;
+using hyped::utils::SimulationClock;
 using hyped::utils::System;
 using hyped::utils::concurrent::Thread;
 
@@ -194,11 +196,20 @@ struct RunTest : public ::testing::Test {
    * Allows the state machine thread to process the central data structure and transition between
    * states.
    *
-   * If tests are failing for no apparent reason, try increasing the sleep duration to be sure this
-   * is not the source of the problem.
+   * The test and the state machine run on a SimulationClock, so the sleep takes no real time and
+   * the state machine always handles the update within it.
    */
   void waitForUpdate() { Thread::sleep(10); }
 
+  /**
+   * Outlives the tests, a failed test leaves its state machine thread behind.
+   */
+  static SimulationClock &getClock()
+  {
+    static SimulationClock clock;
+    return clock;
+  }
+
   // ---- Run steps --------------
 
   /**
@@ -1013,9 +1024,19 @@ struct RunTest : public ::testing::Test {
   }
 
  protected:
-  void SetUp() { disableOutput(); }
+  void SetUp()
+  {
+    disableOutput();
+    getClock().install();
+    getClock().attach();
+  }
 
-  void TearDown() { enableOutput(); }
+  void TearDown()
+  {
+    getClock().detach();
+    getClock().uninstall();
+    enableOutput();
+  }
 };
 
 /**
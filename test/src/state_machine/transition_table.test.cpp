@@ -0,0 +1,134 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that the states only evaluate the guards whose inputs were updated
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "data/data.hpp"
+#include "gtest/gtest.h"
+#include "state_machine/state.hpp"
+#include "state_machine/transitions.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/logger.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace state_machine {
+
+class TransitionTableTest : public ::testing::Test {
+ protected:
+  TransitionTableTest() : log_(false, -1), data_(data::Data::getInstance()) {}
+
+  void SetUp() override
+  {
+    // no emergency, no command and the pod standing at the start of the track
+    data_.setEmergencyBrakesData(data::EmergencyBrakes());
+    data_.setNavigationData(data::Navigation());
+    data_.setBatteriesData(data::Batteries());
+    data_.setTelemetryData(data::Telemetry());
+    data_.setSensorsData(data::Sensors());
+    data_.setMotorData(data::Motors());
+  }
+
+  void TearDown() override
+  {
+    SetUp();
+  }
+
+  /**
+   * @return number of guards state evaluated while checking for a transition once
+   */
+  uint32_t countEvaluations(State *state, State *expected = nullptr)
+  {
+    uint32_t before = state->getGuardEvaluations();
+    EXPECT_EQ(state->checkTransition(log_), expected);
+    return state->getGuardEvaluations() - before;
+  }
+
+  Logger        log_;
+  data::Data&   data_;
+};
+
+TEST_F(TransitionTableTest, evaluatesOnlyGuardsWithUpdatedInputs)
+{
+  State *state = Accelerating::getInstance();
+  // emergency, braking zone and maximum velocity
+  ASSERT_EQ(countEvaluations(state), 3u);
+  ASSERT_EQ(countEvaluations(state), 0u);
+
+  // only the emergency guard reads telemetry
+  data_.setTelemetryData(data::Telemetry());
+  ASSERT_EQ(countEvaluations(state), 1u);
+
+  // no guard reads the temperature
+  data_.setTemperature(20);
+  ASSERT_EQ(countEvaluations(state), 0u);
+
+  data_.setNavigationData(data::Navigation());
+  ASSERT_EQ(countEvaluations(state), 3u);
+}
+
+TEST_F(TransitionTableTest, firstGuardThatHoldsWins)
+{
+  State *state = Cruising::getInstance();
+  countEvaluations(state);
+
+  data::Navigation nav_data = data_.getNavigationData();
+  nav_data.displacement     = data::Navigation::kRunLength;
+  data_.setNavigationData(nav_data);
+  ASSERT_EQ(countEvaluations(state, NominalBraking::getInstance()), 2u);
+
+  // an emergency takes precedence over the braking zone
+  data::Telemetry telemetry_data        = data_.getTelemetryData();
+  telemetry_data.emergency_stop_command = true;
+  data_.setTelemetryData(telemetry_data);
+  ASSERT_EQ(countEvaluations(state, FailureBraking::getInstance()), 1u);
+}
+
+TEST_F(TransitionTableTest, triggerTimeIsThatOfTheChangedInput)
+{
+  State *state = Cruising::getInstance();
+  countEvaluations(state);
+
+  uint64_t before = utils::Timer::getTimeMicros();
+  data::Telemetry telemetry_data        = data_.getTelemetryData();
+  telemetry_data.emergency_stop_command = true;
+  data_.setTelemetryData(telemetry_data);
+  uint64_t after = utils::Timer::getTimeMicros();
+
+  // the emergency row also reads the sensors, which update far more often than the command
+  utils::concurrent::Thread::sleep(2);
+  data_.setSensorsData(data::Sensors());
+  countEvaluations(state, FailureBraking::getInstance());
+  ASSERT_GE(state->getTriggerTime(), before);
+  ASSERT_LE(state->getTriggerTime(), after);
+}
+
+TEST_F(TransitionTableTest, stateReadsOnlyDeclaredData)
+{
+  // the rows leaving Finished only read telemetry, so an update of anything else is ignored
+  ASSERT_EQ(getTransitionReads(1u << static_cast<int>(StateId::kFinished)),
+            static_cast<uint32_t>(data::kChannelTelemetry));
+  State *state = Finished::getInstance();
+  countEvaluations(state);
+  data_.setNavigationData(data::Navigation());
+  ASSERT_EQ(countEvaluations(state), 0u);
+
+  data::Telemetry telemetry_data  = data_.getTelemetryData();
+  telemetry_data.shutdown_command = true;
+  data_.setTelemetryData(telemetry_data);
+  ASSERT_EQ(countEvaluations(state, Off::getInstance()), 1u);
+}
+
+}}  // namespace hyped::state_machine
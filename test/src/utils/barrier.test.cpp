@@ -0,0 +1,117 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests timeout, reuse and cancellation behaviour of utils::concurrent::Barrier
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "utils/concurrent/barrier.hpp"
+#include "utils/concurrent/thread.hpp"
+
+namespace hyped {
+namespace utils {
+namespace concurrent {
+
+/**
+ * @brief Waits on the barrier a given number of times and records how many waits succeeded.
+ */
+class BarrierWaiter : public Thread {
+ public:
+  BarrierWaiter(Barrier* barrier, int rounds)
+      : barrier_(barrier),
+        rounds_(rounds),
+        passed_(0)
+  {}
+
+  void run() override
+  {
+    for (int i = 0; i < rounds_; i++) {
+      if (barrier_->wait()) passed_++;
+    }
+  }
+
+  Barrier*          barrier_;
+  int               rounds_;
+  std::atomic<int>  passed_;
+};
+
+TEST(BarrierTest, tripsWhenAllThreadsArrive)
+{
+  Barrier barrier(2);
+  BarrierWaiter waiter(&barrier, 1);
+  waiter.start();
+  ASSERT_TRUE(barrier.waitFor(1000000));
+  waiter.join();
+  ASSERT_EQ(waiter.passed_, 1);
+  ASSERT_EQ(barrier.getGeneration(), 1u);
+}
+
+TEST(BarrierTest, isReusableAcrossGenerations)
+{
+  constexpr int kRounds = 1000;
+  Barrier barrier(2, 1000);
+  BarrierWaiter waiter(&barrier, kRounds);
+  waiter.start();
+  for (int i = 0; i < kRounds; i++) {
+    ASSERT_TRUE(barrier.wait());
+  }
+  waiter.join();
+  ASSERT_EQ(waiter.passed_, kRounds);
+  ASSERT_EQ(barrier.getGeneration(), static_cast<uint32_t>(kRounds));
+}
+
+TEST(BarrierTest, timeoutWithdrawsArrival)
+{
+  Barrier barrier(2);
+  ASSERT_FALSE(barrier.waitFor(1000));
+
+  // the timed out arrival must not count towards the next generation
+  BarrierWaiter waiter(&barrier, 1);
+  waiter.start();
+  Thread::sleep(10);
+  ASSERT_EQ(barrier.getGeneration(), 0u);
+  ASSERT_TRUE(barrier.waitFor(1000000));
+  waiter.join();
+  ASSERT_EQ(waiter.passed_, 1);
+}
+
+TEST(BarrierTest, cancelReleasesWaitingThreads)
+{
+  Barrier barrier(3);
+  BarrierWaiter waiter(&barrier, 1);
+  waiter.start();
+  Thread::sleep(10);
+  barrier.cancel();
+  waiter.join();
+  ASSERT_EQ(waiter.passed_, 0);
+  ASSERT_TRUE(barrier.isCancelled());
+  ASSERT_FALSE(barrier.wait());
+  ASSERT_FALSE(barrier.waitFor(1000000));
+}
+
+TEST(BarrierTest, requestedCancelReleasesWaitingThreads)
+{
+  Barrier barrier(2);
+  BarrierWaiter waiter(&barrier, 1);
+  waiter.start();
+  Thread::sleep(10);
+  barrier.requestCancel();
+  waiter.join();
+  ASSERT_EQ(waiter.passed_, 0);
+  ASSERT_FALSE(barrier.wait());
+}
+
+}}}  // namespace hyped::utils::concurrent
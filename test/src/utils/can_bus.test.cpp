@@ -0,0 +1,362 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Integration tests and benchmarks of utils::io::Can with BMSHP and CanSender.
+ *              Runs on vcan0 if the interface exists, otherwise on a socketpair standing in
+ *              for the bus. Benchmarks print their results and only assert correctness.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <sys/socket.h>
+#include <net/if.h>
+
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "propulsion/can/can_sender.hpp"
+#include "propulsion/controller_interface.hpp"
+#include "sensors/bms.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/io/can.hpp"
+#include "utils/logger.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+using concurrent::Thread;
+
+/**
+ * @brief Counts frames of one id and measures the time from kernel receive to dispatch
+ */
+class CountingProcessor : public CanProccesor {
+ public:
+  explicit CountingProcessor(uint32_t id)
+      : id_(id),
+        count_(0),
+        total_latency_(0),
+        max_latency_(0),
+        last_frame_ {}
+  {}
+
+  void processNewData(can::Frame& message) override
+  {
+    uint64_t now     = Timer::getTimeMicros();
+    uint64_t latency = now > message.timestamp ? now - message.timestamp : 0;
+    total_latency_ += latency;
+    max_latency_    = std::max<uint64_t>(max_latency_, latency);
+    last_frame_     = message;
+    count_++;
+  }
+
+  bool hasId(uint32_t id, bool extended) override { return id == id_ && !extended; }
+
+  void getIdRanges(std::vector<can::IdRange>* ranges) override
+  {
+    ranges->push_back({id_, id_, false});
+  }
+
+  uint32_t              id_;
+  std::atomic<uint32_t> count_;
+  std::atomic<uint64_t> total_latency_;
+  std::atomic<uint64_t> max_latency_;
+  can::Frame            last_frame_;
+};
+
+/**
+ * @brief Motor controller end of the bus, acknowledges every SDO request it receives
+ */
+class SimulatedController : public CanProccesor {
+ public:
+  SimulatedController(Can* can, uint8_t node_id)
+      : can_(can),
+        node_id_(node_id)
+  {}
+
+  void processNewData(can::Frame& message) override
+  {
+    can::Frame response = {};
+    response.id       = kSdoTransmit + node_id_;
+    response.len      = 8;
+    response.data[0]  = 0x60;   // download response
+    response.data[1]  = message.data[1];
+    response.data[2]  = message.data[2];
+    response.data[3]  = message.data[3];
+    can_->send(response);
+  }
+
+  bool hasId(uint32_t id, bool extended) override
+  {
+    return id == kSdoReceive + node_id_ && !extended;
+  }
+
+  void getIdRanges(std::vector<can::IdRange>* ranges) override
+  {
+    ranges->push_back({kSdoReceive + node_id_, kSdoReceive + node_id_, false});
+  }
+
+  static constexpr uint32_t kSdoReceive  = 0x600;
+  static constexpr uint32_t kSdoTransmit = 0x580;
+
+ private:
+  Can*    can_;
+  uint8_t node_id_;
+};
+
+/**
+ * @brief Records the SDO responses CanSender hands to its controller
+ */
+class SdoRecorder : public motor_control::ControllerInterface {
+ public:
+  SdoRecorder()
+      : responses_(0),
+        last_index_(0)
+  {}
+
+  void processSdoMessage(can::Frame& message) override
+  {
+    last_index_ = message.data[1] | (message.data[2] << 8);
+    responses_++;
+  }
+
+  void registerController() override {}
+  void configure() override {}
+  void enterOperational() override {}
+  void enterPreOperational() override {}
+  void checkState() override {}
+  void sendTargetVelocity(int32_t target_velocity) override {}
+  void updateActualVelocity() override {}
+  int32_t getVelocity() override { return 0; }
+  void quickStop() override {}
+  void healthCheck() override {}
+  bool getFailure() override { return false; }
+  void updateMotorTemp() override {}
+  uint8_t getMotorTemp() override { return 0; }
+  motor_control::ControllerState getControllerState() override
+  {
+    return motor_control::kSwitchOnDisabled;
+  }
+  void processEmergencyMessage(can::Frame& message) override {}
+  void processErrorMessage(uint16_t error_message) override {}
+  void processNmtMessage(can::Frame& message) override {}
+  void processPdoMessage(can::Frame& message) override {}
+  void requestStateTransition(can::Frame& message, motor_control::ControllerState state) override
+  {}
+
+  std::atomic<uint32_t> responses_;
+  std::atomic<uint16_t> last_index_;
+};
+
+class CanBusTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    if (if_nametoindex("vcan0") != 0) {
+      dut_.reset(new Can("vcan0"));
+      peer_.reset(new Can("vcan0"));
+    }
+    stand_in_ = !dut_ || !dut_->isOpen() || !peer_->isOpen();
+    if (stand_in_) {
+      int fds[2];
+      ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds), 0);
+      dut_.reset(new Can(fds[0]));
+      peer_.reset(new Can(fds[1]));
+    }
+    ASSERT_TRUE(dut_->isOpen());
+    ASSERT_TRUE(peer_->isOpen());
+  }
+
+  void TearDown() override
+  {
+    // buses first, processors registered with them must outlive them
+    dut_.reset();
+    peer_.reset();
+    owned_.clear();
+  }
+
+  /**
+   * @brief Keep object alive until both buses are gone
+   */
+  template<typename T>
+  T* keep(T* object)
+  {
+    owned_.push_back(std::shared_ptr<T>(object));
+    return object;
+  }
+
+  static can::Frame makeFrame(uint32_t id)
+  {
+    can::Frame frame = {};
+    frame.id  = id;
+    frame.len = 8;
+    return frame;
+  }
+
+  /**
+   * @brief Poll condition every millisecond, false if it did not hold within timeout
+   */
+  static bool waitUntil(std::function<bool()> condition, uint32_t timeout_ms)
+  {
+    for (uint32_t i = 0; i < timeout_ms; i++) {
+      if (condition()) return true;
+      Thread::sleep(1);
+    }
+    return condition();
+  }
+
+  std::vector<std::shared_ptr<void>>  owned_;
+  std::unique_ptr<Can>                dut_;
+  std::unique_ptr<Can>                peer_;
+  bool                                stand_in_;
+};
+
+TEST_F(CanBusTest, deliversFramesToOwner)
+{
+  CountingProcessor* processor = keep(new CountingProcessor(0x123));
+  dut_->registerProcessor(processor);
+  dut_->start();
+  peer_->start();
+
+  can::Frame frame = makeFrame(0x123);
+  frame.data[7] = 0x42;
+  uint64_t sent_at = Timer::getTimeMicros();
+  ASSERT_EQ(peer_->send(frame), 1);
+  ASSERT_EQ(peer_->send(makeFrame(0x124)), 1);    // nobody owns it
+  ASSERT_TRUE(waitUntil([&] { return processor->count_ == 1; }, 1000));
+
+  ASSERT_EQ(processor->last_frame_.data[7], 0x42);
+  ASSERT_GE(processor->last_frame_.timestamp, sent_at);
+  ASSERT_LE(processor->last_frame_.timestamp, Timer::getTimeMicros());
+  ASSERT_TRUE(waitUntil([&] { return peer_->getTxStats().sent == 2; }, 1000));
+
+  ASSERT_EQ(peer_->getStats().tx_frames, 2u);
+  can::BusStats stats = dut_->getStats();
+  ASSERT_EQ(stats.ids.size(), 1u + (dut_->getStats().rx_frames == 2));  // filters only on CAN
+  ASSERT_EQ(stats.ids[0].id, 0x123u);
+  ASSERT_EQ(stats.ids[0].last_seen, processor->last_frame_.timestamp);
+  ASSERT_GT(stats.bits, 0u);
+}
+
+TEST_F(CanBusTest, bmshpDecodesBroadcast)
+{
+  sensors::BMSHP* bms = keep(new sensors::BMSHP(0, System::getLogger(), *dut_));
+  dut_->start();
+  peer_->start();
+
+  can::Frame frame = makeFrame(0x6B0);
+  frame.data[0] = 0x03;   // 80.0 V
+  frame.data[1] = 0x20;
+  frame.data[4] = 150;    // 75 %
+  ASSERT_EQ(peer_->send(frame), 1);
+
+  data::BatteryData battery;
+  ASSERT_TRUE(waitUntil([&] {
+    bms->getData(&battery);
+    return battery.voltage == 800;
+  }, 1000));
+  ASSERT_EQ(battery.charge, 75);
+  ASSERT_TRUE(bms->isOnline());
+}
+
+TEST_F(CanBusTest, canSenderCompletesSdoRoundTrip)
+{
+  Logger quiet(false, 0);
+  SdoRecorder* controller = keep(new SdoRecorder());
+  motor_control::CanSender* sender = keep(new motor_control::CanSender(controller, 1, quiet,
+                                                                       *dut_));
+  sender->registerController();
+  peer_->registerProcessor(keep(new SimulatedController(peer_.get(), 1)));
+  peer_->start();
+
+  can::Frame request = makeFrame(0x601);
+  request.data[0] = 0x2B;
+  request.data[1] = 0x40;   // index 0x6040
+  request.data[2] = 0x60;
+  ASSERT_TRUE(sender->sendMessage(request));
+  ASSERT_EQ(controller->responses_, 1u);
+  ASSERT_EQ(controller->last_index_, 0x6040);
+}
+
+TEST_F(CanBusTest, benchmarkReceiveThroughputAndDispatchLatency)
+{
+  constexpr uint32_t kFrames = 20000;
+  CountingProcessor* processor = keep(new CountingProcessor(0x181));
+  dut_->registerProcessor(processor);
+  dut_->start();
+  peer_->start();
+
+  uint64_t start = Timer::getTimeMicros();
+  for (uint32_t i = 0; i < kFrames; i++) {
+    while (!peer_->send(makeFrame(0x181))) Thread::yield();   // queue full, back off
+  }
+  waitUntil([&] { return processor->count_ == kFrames; }, 10000);
+  uint64_t elapsed = Timer::getTimeMicros() - start;
+
+  uint32_t received = processor->count_;
+  if (stand_in_) {
+    ASSERT_EQ(received, kFrames);
+  } else {
+    ASSERT_GE(received, kFrames * 9 / 10);    // a real socket may drop under overload
+  }
+  RecordProperty("bus", stand_in_ ? "socketpair" : "vcan0");
+  RecordProperty("frames_per_second", static_cast<int>(received * 1000000.0 / elapsed));
+  RecordProperty("mean_latency_us", static_cast<int>(processor->total_latency_ / received));
+  RecordProperty("max_latency_us", static_cast<int>(processor->max_latency_));
+}
+
+TEST_F(CanBusTest, benchmarkSdoRoundTrip)
+{
+  constexpr uint32_t kRequests = 1000;
+  Logger quiet(false, 0);
+  SdoRecorder* controller = keep(new SdoRecorder());
+  motor_control::CanSender* sender = keep(new motor_control::CanSender(controller, 2, quiet,
+                                                                       *dut_));
+  sender->registerController();
+  peer_->registerProcessor(keep(new SimulatedController(peer_.get(), 2)));
+  peer_->start();
+
+  uint64_t total = 0;
+  uint64_t worst = 0;
+  for (uint32_t i = 0; i < kRequests; i++) {
+    can::Frame request = makeFrame(0x602);
+    request.data[0] = 0x40;
+    request.data[1] = i & 0xFF;
+    uint64_t start = Timer::getTimeMicros();
+    ASSERT_TRUE(sender->sendMessage(request));
+    uint64_t rtt = Timer::getTimeMicros() - start;
+    total += rtt;
+    worst  = std::max(worst, rtt);
+  }
+  ASSERT_EQ(controller->responses_, kRequests);
+  RecordProperty("bus", stand_in_ ? "socketpair" : "vcan0");
+  RecordProperty("mean_round_trip_us", static_cast<int>(total / kRequests));
+  RecordProperty("max_round_trip_us", static_cast<int>(worst));
+}
+
+TEST(CanRegistry, oneBusPerInterface)
+{
+  Can& motors = Can::getMotorBus();
+  ASSERT_EQ(&motors, &Can::getInstance("vcan1"));   // see test/config.txt
+  ASSERT_EQ(&Can::getBmsBus(), &Can::getInstance());
+  ASSERT_NE(&motors, &Can::getInstance());
+  ASSERT_STREQ(motors.getInterface(), "vcan1");
+  ASSERT_STREQ(Can::getInstance().getInterface(), "can0");
+}
+
+}}}  // namespace hyped::utils::io
@@ -0,0 +1,311 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests CanDispatcher owner lookup and receive filters. Benchmarks the lookup
+ *              against the linear hasId() scan using the CAN processors of the pod and
+ *              a realistic frame mix.
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "propulsion/can/can_sender.hpp"
+#include "sensors/bms.hpp"
+#include "utils/io/can.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+/**
+ * @brief Owns the declared id ranges, hasId() is implemented on top of them.
+ */
+class RangeProcessor : public CanProccesor {
+ public:
+  explicit RangeProcessor(std::vector<can::IdRange> ranges)
+      : ranges_(ranges)
+  {}
+
+  void processNewData(can::Frame& message) override {}
+
+  bool hasId(uint32_t id, bool extended) override
+  {
+    for (const can::IdRange& range : ranges_) {
+      if (range.extended == extended && range.first <= id && id <= range.last) return true;
+    }
+    return false;
+  }
+
+  void getIdRanges(std::vector<can::IdRange>* ranges) override
+  {
+    ranges->insert(ranges->end(), ranges_.begin(), ranges_.end());
+  }
+
+ private:
+  std::vector<can::IdRange> ranges_;
+};
+
+/**
+ * @brief Does not declare any ids, only answers hasId().
+ */
+class UndeclaredProcessor : public CanProccesor {
+ public:
+  explicit UndeclaredProcessor(uint32_t id)
+      : id_(id)
+  {}
+
+  void processNewData(can::Frame& message) override {}
+  bool hasId(uint32_t id, bool extended) override { return id == id_; }
+
+ private:
+  uint32_t id_;
+};
+
+TEST(CanDispatcherTest, findsOwnerOfDeclaredIds)
+{
+  RangeProcessor small({{0x580, 0x583, false}});
+  RangeProcessor wide({{0x18000000, 0x18FFFFFF, true}});
+  CanDispatcher dispatcher;
+  dispatcher.add(&small);
+  dispatcher.add(&wide);
+
+  ASSERT_EQ(dispatcher.find(0x580, false), &small);
+  ASSERT_EQ(dispatcher.find(0x583, false), &small);
+  ASSERT_EQ(dispatcher.find(0x18000000, true), &wide);
+  ASSERT_EQ(dispatcher.find(0x1839F380, true), &wide);
+  ASSERT_EQ(dispatcher.find(0x18FFFFFF, true), &wide);
+}
+
+TEST(CanDispatcherTest, distinguishesStandardAndExtendedIds)
+{
+  RangeProcessor standard({{0x28, 0x28, false}});
+  RangeProcessor extended({{0x28, 0x28, true}});
+  CanDispatcher dispatcher;
+  dispatcher.add(&standard);
+  dispatcher.add(&extended);
+
+  ASSERT_EQ(dispatcher.find(0x28, false), &standard);
+  ASSERT_EQ(dispatcher.find(0x28, true), &extended);
+}
+
+TEST(CanDispatcherTest, returnsNullForUnownedIds)
+{
+  RangeProcessor small({{0x580, 0x583, false}});
+  RangeProcessor wide({{0x18000000, 0x18FFFFFF, true}});
+  CanDispatcher dispatcher;
+  dispatcher.add(&small);
+  dispatcher.add(&wide);
+
+  ASSERT_EQ(dispatcher.find(0x584, false), nullptr);
+  ASSERT_EQ(dispatcher.find(0x580, true), nullptr);
+  ASSERT_EQ(dispatcher.find(0x17FFFFFF, true), nullptr);
+  ASSERT_EQ(dispatcher.find(0x19000000, true), nullptr);
+}
+
+TEST(CanDispatcherTest, firstRegisteredProcessorOwnsSharedIds)
+{
+  RangeProcessor first({{0x80, 0x80, false}});
+  RangeProcessor second({{0x80, 0x83, false}});
+  CanDispatcher dispatcher;
+  dispatcher.add(&first);
+  dispatcher.add(&second);
+
+  ASSERT_EQ(dispatcher.find(0x80, false), &first);
+  ASSERT_EQ(dispatcher.find(0x81, false), &second);
+}
+
+TEST(CanDispatcherTest, fallsBackToHasIdForUndeclaredProcessors)
+{
+  RangeProcessor declared({{0x600, 0x600, false}});
+  UndeclaredProcessor undeclared(0x700);
+  CanDispatcher dispatcher;
+  dispatcher.add(&undeclared);
+  dispatcher.add(&declared);
+
+  ASSERT_EQ(dispatcher.find(0x600, false), &declared);
+  ASSERT_EQ(dispatcher.find(0x700, false), &undeclared);
+  ASSERT_EQ(dispatcher.find(0x701, false), nullptr);
+}
+
+/**
+ * @return true iff the frame passes at least one of the filters, same as the SocketCAN check
+ */
+bool passes(const std::vector<can::Filter>& filters, uint32_t id, bool extended)
+{
+  uint32_t raw_id = id | (extended ? can::Frame::kExtendedMask : 0);
+  for (const can::Filter& filter : filters) {
+    if ((raw_id & filter.mask) == (filter.id & filter.mask)) return true;
+  }
+  return false;
+}
+
+TEST(CanDispatcherTest, filtersPassExactlyOwnedStandardIds)
+{
+  RangeProcessor sdo({{0x580, 0x583, false}, {0x700, 0x703, false}});
+  RangeProcessor bms({{0x6B0, 0x6B3, false}, {0x36, 0x37, false}, {0x7E4, 0x7E4, false}});
+  RangeProcessor odd({{0x101, 0x17E, false}, {0x17F, 0x200, false}});   // merged, unaligned
+  CanDispatcher dispatcher;
+  dispatcher.add(&sdo);
+  dispatcher.add(&bms);
+  dispatcher.add(&odd);
+
+  std::vector<can::Filter> filters;
+  ASSERT_TRUE(dispatcher.getFilters(&filters));
+  ASSERT_LE(filters.size(), CanDispatcher::kMaxFilters);
+  for (uint32_t id = 0; id <= can::Filter::kStandardIdMask; id++) {
+    bool owned = dispatcher.find(id, false) != nullptr;
+    ASSERT_EQ(passes(filters, id, false), owned) << "id " << id;
+    ASSERT_FALSE(passes(filters, id, true)) << "extended id " << id;
+  }
+}
+
+TEST(CanDispatcherTest, filtersPassExactlyOwnedExtendedIds)
+{
+  RangeProcessor therm({{0x1839F380, 0x1839F381, true}, {0x18EEFF80, 0x18EEFF81, true}});
+  RangeProcessor wide({{0x10000001, 0x10FFFFFE, true}});
+  RangeProcessor bms({{301, 304, true}, {0x28, 0x28, true}});
+  CanDispatcher dispatcher;
+  dispatcher.add(&therm);
+  dispatcher.add(&wide);
+  dispatcher.add(&bms);
+
+  std::vector<can::Filter> filters;
+  ASSERT_TRUE(dispatcher.getFilters(&filters));
+  const uint32_t boundaries[] = {0, 0x28, 301, 304, 0x1839F380, 0x1839F381, 0x18EEFF80,
+                                 0x18EEFF81, 0x10000001, 0x10800000, 0x10FFFFFE,
+                                 can::Filter::kExtendedIdMask};
+  for (uint32_t boundary : boundaries) {
+    for (uint32_t id = boundary > 4 ? boundary - 4 : 0; id <= boundary + 4; id++) {
+      if (id > can::Filter::kExtendedIdMask) break;
+      bool owned = dispatcher.find(id, true) != nullptr;
+      ASSERT_EQ(passes(filters, id, true), owned) << "id " << id;
+      if (id <= can::Filter::kStandardIdMask) {
+        ASSERT_FALSE(passes(filters, id, false));
+      }
+    }
+  }
+}
+
+TEST(CanDispatcherTest, noFiltersWithUndeclaredProcessor)
+{
+  RangeProcessor declared({{0x600, 0x600, false}});
+  UndeclaredProcessor undeclared(0x700);
+  CanDispatcher dispatcher;
+  dispatcher.add(&declared);
+
+  std::vector<can::Filter> filters;
+  ASSERT_TRUE(dispatcher.getFilters(&filters));
+  ASSERT_EQ(filters.size(), 1u);
+
+  dispatcher.add(&undeclared);
+  ASSERT_FALSE(dispatcher.getFilters(&filters));
+  ASSERT_TRUE(filters.empty());
+}
+
+/**
+ * Registers the CAN processors used on the pod (3 LP BMS, 2 HP BMS, 4 motor controllers) and
+ * dispatches a frame mix dominated by motor controller SDO responses and BMS broadcasts.
+ */
+TEST(CanDispatcherTest, benchmarkRealisticFrameMix)
+{
+  static std::vector<CanProccesor*> processors;
+  if (processors.empty()) {
+    Logger& log = System::getLogger();
+    for (uint8_t i = 0; i < data::Batteries::kNumLPBatteries; i++) {
+      processors.push_back(new sensors::BMS(i, log));
+    }
+    for (uint16_t i = 0; i < data::Batteries::kNumHPBatteries; i++) {
+      processors.push_back(new sensors::BMSHP(i, log));
+    }
+    for (uint8_t i = 0; i < data::Motors::kNumMotors; i++) {
+      processors.push_back(new motor_control::CanSender(log, i));
+    }
+  }
+
+  CanDispatcher dispatcher;
+  for (CanProccesor* processor : processors) dispatcher.add(processor);
+
+  struct MixEntry { uint32_t id; bool extended; int weight; };
+  const MixEntry mix[] = {
+    {0x580, false, 20}, {0x581, false, 20}, {0x582, false, 20}, {0x583, false, 20},  // SDO
+    {0x700, false, 2},  {0x703, false, 2},  {0x81, false, 1},                         // NMT, EMCY
+    {0x6B0, false, 8},  {0x6B1, false, 8},  {0x6B2, false, 8},  {0x6B3, false, 8},    // HP BMS
+    {0x36, false, 10},  {0x37, false, 10},                                            // cells
+    {0x1839F380, true, 4}, {0x1839F381, true, 4}, {0x18EEFF80, true, 1},              // therm
+    {301, true, 3}, {312, true, 3}, {324, true, 3}, {0x28, true, 3},                  // LP BMS
+    {0x123, false, 1}, {0x10000000, true, 1},                                         // unowned
+  };
+  std::vector<can::Frame> frames;
+  for (const MixEntry& entry : mix) {
+    for (int i = 0; i < entry.weight; i++) {
+      can::Frame frame = {};
+      frame.id       = entry.id;
+      frame.extended = entry.extended;
+      frames.push_back(frame);
+    }
+  }
+
+  // both strategies must agree on every owner
+  for (can::Frame& frame : frames) {
+    CanProccesor* linear_owner = nullptr;
+    for (CanProccesor* processor : processors) {
+      if (processor->hasId(frame.id, frame.extended)) {
+        linear_owner = processor;
+        break;
+      }
+    }
+    ASSERT_EQ(dispatcher.find(frame.id, frame.extended), linear_owner);
+  }
+
+  constexpr int kIterations = 5000;
+  const double num_frames = static_cast<double>(kIterations) * frames.size();
+  uintptr_t checksum = 0;
+
+  uint64_t start = Timer::getTimeMicros();
+  for (int i = 0; i < kIterations; i++) {
+    for (can::Frame& frame : frames) {
+      for (CanProccesor* processor : processors) {
+        if (processor->hasId(frame.id, frame.extended)) {
+          checksum += reinterpret_cast<uintptr_t>(processor);
+          break;
+        }
+      }
+    }
+  }
+  uint64_t linear_micros = Timer::getTimeMicros() - start;
+
+  start = Timer::getTimeMicros();
+  for (int i = 0; i < kIterations; i++) {
+    for (can::Frame& frame : frames) {
+      checksum -= reinterpret_cast<uintptr_t>(dispatcher.find(frame.id, frame.extended));
+    }
+  }
+  uint64_t table_micros = Timer::getTimeMicros() - start;
+
+  ASSERT_EQ(checksum, 0u);
+
+  std::vector<can::Filter> filters;
+  ASSERT_TRUE(dispatcher.getFilters(&filters));
+  for (can::Frame& frame : frames) {
+    ASSERT_EQ(passes(filters, frame.id, frame.extended),
+              dispatcher.find(frame.id, frame.extended) != nullptr);
+  }
+
+  RecordProperty("linear_scan_ns_per_frame", static_cast<int>(linear_micros * 1000 / num_frames));
+  RecordProperty("table_ns_per_frame", static_cast<int>(table_micros * 1000 / num_frames));
+}
+
+}}}  // namespace hyped::utils::io
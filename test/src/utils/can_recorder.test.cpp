@@ -0,0 +1,158 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests CAN recording round trip, candump export and replay timing
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/io/can_recorder.hpp"
+#include "utils/system.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+class CanRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override
+  {
+    char path[] = "/tmp/hyped_can_recordXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    path_ = path;
+  }
+
+  void TearDown() override
+  {
+    unlink(path_.c_str());
+  }
+
+  static can::Frame makeFrame(uint32_t id, bool extended, uint64_t timestamp)
+  {
+    can::Frame frame = {};
+    frame.id        = id;
+    frame.extended  = extended;
+    frame.len       = 2;
+    frame.data[0]   = 0xAB;
+    frame.data[1]   = 0x01;
+    frame.timestamp = timestamp;
+    return frame;
+  }
+
+  std::string path_;
+};
+
+TEST_F(CanRecorderTest, readsBackRecordedFrames)
+{
+  CanRecorder recorder(System::getLogger());
+  ASSERT_TRUE(recorder.open(path_.c_str()));
+  recorder.record(makeFrame(0x581, false, 1000), false);
+  recorder.record(makeFrame(0x601, false, 1500), true);
+  recorder.record(makeFrame(0x1839F380, true, 2000), false);
+  ASSERT_EQ(recorder.getCount(), 3u);
+  recorder.close();
+
+  std::vector<can::Record> records;
+  uint64_t epoch_offset = 0;
+  ASSERT_TRUE(CanRecorder::read(path_.c_str(), &records, &epoch_offset));
+  ASSERT_EQ(records.size(), 3u);
+  ASSERT_EQ(epoch_offset, Timer::toEpochMicros(0));
+  ASSERT_EQ(records[0].id, 0x581u);
+  ASSERT_EQ(records[0].flags, 0);
+  ASSERT_EQ(records[1].flags, can::Record::kTransmitted);
+  ASSERT_EQ(records[2].flags, can::Record::kExtended);
+  ASSERT_EQ(records[2].timestamp, 2000u);
+  ASSERT_EQ(records[2].len, 2);
+  ASSERT_EQ(records[2].data[0], 0xAB);
+}
+
+TEST_F(CanRecorderTest, rejectsOtherFiles)
+{
+  FILE* file = fopen(path_.c_str(), "w");
+  fprintf(file, "(1602518400.000123) can0 581#4B40600000000000\n");
+  fclose(file);
+
+  std::vector<can::Record> records;
+  ASSERT_FALSE(CanRecorder::read(path_.c_str(), &records));
+}
+
+TEST_F(CanRecorderTest, formatsCandumpLines)
+{
+  can::Record record = {};
+  record.timestamp = 123;
+  record.id        = 0x581;
+  record.len       = 3;
+  record.data[0]   = 0x4B;
+  record.data[1]   = 0x40;
+  record.data[2]   = 0x0F;
+
+  char line[128];
+  CanRecorder::formatCandump(record, 1602518400000000ULL, "can0", line, sizeof(line));
+  ASSERT_STREQ(line, "(1602518400.000123) can0 581#4B400F");
+
+  record.id    = 0x1839F380;
+  record.flags = can::Record::kExtended;
+  record.len   = 0;
+  CanRecorder::formatCandump(record, 0, "vcan0", line, sizeof(line));
+  ASSERT_STREQ(line, "(0.000123) vcan0 1839F380#");
+}
+
+/**
+ * @brief Records the time every frame is written at
+ */
+class TimedWriter {
+ public:
+  int write(const can::Frame& frame)
+  {
+    ids_.push_back(frame.id);
+    times_.push_back(Timer::getTimeMicros());
+    return 0;
+  }
+
+  std::vector<uint32_t> ids_;
+  std::vector<uint64_t> times_;
+};
+
+TEST_F(CanRecorderTest, replaysWithScaledTiming)
+{
+  std::vector<can::Record> records(3);
+  records[0].id = 0x581; records[0].timestamp = 10000;
+  records[1].id = 0x601; records[1].timestamp = 15000; records[1].flags = can::Record::kTransmitted;
+  records[2].id = 0x582; records[2].timestamp = 50000;
+
+  TimedWriter writer;
+  CanReplayer replayer([&writer](const can::Frame& f) { return writer.write(f); },
+                       System::getLogger());
+
+  // transmitted frames are skipped unless asked for
+  ASSERT_EQ(replayer.replay(records, 2.0), 2u);
+  ASSERT_EQ(writer.ids_, std::vector<uint32_t>({0x581, 0x582}));
+  ASSERT_GE(writer.times_[1] - writer.times_[0], 20000u - 1000u);   // 40ms at double speed
+
+  writer.ids_.clear();
+  writer.times_.clear();
+  ASSERT_EQ(replayer.replay(records, 0, true), 3u);
+  ASSERT_EQ(writer.ids_, std::vector<uint32_t>({0x581, 0x601, 0x582}));
+  ASSERT_LT(writer.times_[2] - writer.times_[0], 20000u);
+}
+
+}}}  // namespace hyped::utils::io
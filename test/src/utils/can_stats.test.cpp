@@ -0,0 +1,115 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests CAN frame length estimation, per-id statistics and bus utilisation
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <stdlib.h>
+
+#include "gtest/gtest.h"
+#include "utils/io/can_stats.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+static can::Frame makeFrame(uint32_t id, bool extended, uint8_t len, uint64_t timestamp = 0)
+{
+  can::Frame frame = {};
+  frame.id        = id;
+  frame.extended  = extended;
+  frame.len       = len;
+  frame.timestamp = timestamp;
+  return frame;
+}
+
+TEST(CanStats, countsStuffBits)
+{
+  // 34 dominant bits from start of frame to the end of the CRC get a stuff bit every 5 bits
+  ASSERT_EQ(CanStats::getFrameBits(makeFrame(0, false, 0)), 34u + 6u + 13u);
+}
+
+TEST(CanStats, frameBitsWithinStuffingBounds)
+{
+  srand(42);
+  for (int i = 0; i < 1000; i++) {
+    bool    extended = i % 2;
+    uint8_t len      = rand() % 9;
+    can::Frame frame = makeFrame(rand() & (extended ? 0x1FFFFFFF : 0x7FF), extended, len);
+    for (int j = 0; j < len; j++) frame.data[j] = rand();
+
+    // bits exposed to stuffing and the worst case number of stuff bits for them
+    uint32_t stuffed = (extended ? 54 : 34) + 8 * len;
+    uint32_t bits    = CanStats::getFrameBits(frame);
+    ASSERT_GE(bits, stuffed + 13);
+    ASSERT_LE(bits, stuffed + 13 + (stuffed - 1) / 4);
+  }
+}
+
+TEST(CanStats, tracksIntervalsPerId)
+{
+  CanStats stats;
+  uint64_t time = 1000;
+  for (int i = 0; i < 10; i++) {
+    stats.addReceived(makeFrame(0x181, false, 8, time));
+    time += (i % 2) ? 900 : 1100;
+  }
+  stats.addReceived(makeFrame(0x181, true, 8, time));
+  stats.addTransmitted(makeFrame(0x601, false, 8), time + 10);
+  stats.addTransmitError(makeFrame(0x601, false, 8));
+  stats.addErrorFrame(0x40);
+
+  can::BusStats snapshot = stats.getSnapshot();
+  ASSERT_EQ(snapshot.rx_frames, 11u);
+  ASSERT_EQ(snapshot.tx_frames, 1u);
+  ASSERT_EQ(snapshot.error_frames, 1u);
+  ASSERT_EQ(snapshot.last_error_class, 0x40u);
+  ASSERT_EQ(snapshot.ids.size(), 3u);
+
+  const can::IdStats& periodic = snapshot.ids[0];
+  ASSERT_EQ(periodic.id, 0x181u);
+  ASSERT_FALSE(periodic.extended);
+  ASSERT_EQ(periodic.rx_frames, 10u);
+  ASSERT_NEAR(periodic.mean_interval, 1000 + 100.0 / 9, 0.1);  // 5 long, 4 short
+  ASSERT_NEAR(periodic.jitter, 100, 10);
+
+  ASSERT_EQ(snapshot.ids[1].id, 0x601u);
+  ASSERT_EQ(snapshot.ids[1].tx_frames, 1u);
+  ASSERT_EQ(snapshot.ids[1].tx_errors, 1u);
+  ASSERT_EQ(snapshot.ids[1].last_seen, time + 10);
+  ASSERT_TRUE(snapshot.ids[2].extended);   // extended ids after all standard ones
+  ASSERT_EQ(snapshot.ids[2].jitter, 0);
+}
+
+TEST(CanStats, estimatesUtilisation)
+{
+  CanStats stats(500000);
+  can::Frame frame = makeFrame(0, false, 0);
+  uint32_t bits = CanStats::getFrameBits(frame);
+
+  // one frame every 4 frame times, kept ahead of the clock so the complete window is reported
+  uint64_t start = Timer::getTimeMicros() + CanStats::kWindow;
+  uint64_t step  = 4 * bits * 2;    // 2 us per bit at 500 kbit/s
+  for (uint64_t time = start; time <= start + CanStats::kWindow + step; time += step) {
+    frame.timestamp = time;
+    stats.addReceived(frame);
+  }
+
+  can::BusStats snapshot = stats.getSnapshot();
+  ASSERT_EQ(snapshot.bitrate, 500000u);
+  ASSERT_NEAR(snapshot.utilisation, 0.25, 0.01);
+}
+
+}}}  // namespace hyped::utils::io
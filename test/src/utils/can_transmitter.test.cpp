@@ -0,0 +1,228 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests ordering, retries, backpressure and statistics of CanTransmitter
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <errno.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/concurrent/lock.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/io/can_transmitter.hpp"
+#include "utils/system.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+/**
+ * @brief Stands in for the socket. Records written ids and fails the first writes
+ * with a configurable error.
+ */
+class FakeWriter {
+ public:
+  FakeWriter()
+      : failures_(0),
+        error_(0)
+  {}
+
+  int write(const can::Frame& frame)
+  {
+    if (failures_ > 0) {
+      failures_--;
+      return error_;
+    }
+    concurrent::ScopedLock L(&lock_);
+    written_.push_back(frame.id);
+    return 0;
+  }
+
+  std::vector<uint32_t> getWritten()
+  {
+    concurrent::ScopedLock L(&lock_);
+    return written_;
+  }
+
+  std::atomic<int>      failures_;
+  int                   error_;
+
+ private:
+  concurrent::Lock      lock_;
+  std::vector<uint32_t> written_;
+};
+
+can::Frame makeFrame(uint32_t id, bool extended = false)
+{
+  can::Frame frame = {};
+  frame.id       = id;
+  frame.extended = extended;
+  frame.len      = 1;
+  return frame;
+}
+
+/**
+ * @brief Counts completion callbacks of the transmitter
+ */
+class Completions {
+ public:
+  Completions()
+      : sent_(0),
+        failed_(0)
+  {}
+
+  can::TxCallback getCallback()
+  {
+    return std::bind(&Completions::complete, this, std::placeholders::_1, std::placeholders::_2);
+  }
+
+  void complete(const can::Frame& frame, bool sent)
+  {
+    if (sent) {
+      sent_++;
+    } else {
+      failed_++;
+    }
+  }
+
+  /**
+   * @brief Wait for the transmit thread to finish count frames, fails after a second
+   */
+  void waitFor(int count)
+  {
+    for (int i = 0; i < 1000 && sent_ + failed_ < count; i++) concurrent::Thread::sleep(1);
+    ASSERT_EQ(sent_ + failed_, count);
+  }
+
+  std::atomic<int> sent_;
+  std::atomic<int> failed_;
+};
+
+TEST(CanTransmitterTest, ordersFramesLikeBusArbitration)
+{
+  ASSERT_LT(CanTransmitter::getArbitrationKey(makeFrame(0x080)),
+            CanTransmitter::getArbitrationKey(makeFrame(0x600)));
+  // standard frame wins over extended frame with the same base id
+  ASSERT_LT(CanTransmitter::getArbitrationKey(makeFrame(0x28)),
+            CanTransmitter::getArbitrationKey(makeFrame(0x28 << 18, true)));
+  // extended frame with lower base id wins over standard frame
+  ASSERT_LT(CanTransmitter::getArbitrationKey(makeFrame(0x1FFFF, true)),
+            CanTransmitter::getArbitrationKey(makeFrame(0x001)));
+}
+
+TEST(CanTransmitterTest, sendsQueuedFramesInPriorityOrder)
+{
+  FakeWriter writer;
+  CanTransmitter transmitter([&writer](const can::Frame& f) { return writer.write(f); },
+                             System::getLogger());
+  Completions completions;
+  can::TxCallback callback = completions.getCallback();
+
+  // queued before the thread runs, so all of them compete
+  const uint32_t ids[] = {0x601, 0x701, 0x081, 0x601, 0x000};
+  for (uint32_t id : ids) ASSERT_TRUE(transmitter.enqueue(makeFrame(id), callback));
+  transmitter.start();
+  completions.waitFor(5);
+  ASSERT_EQ(completions.sent_, 5);
+
+  std::vector<uint32_t> expected = {0x000, 0x081, 0x601, 0x601, 0x701};
+  ASSERT_EQ(writer.getWritten(), expected);
+  can::TxStats stats = transmitter.getStats();
+  ASSERT_EQ(stats.sent, 5u);
+  ASSERT_EQ(stats.max_queue_depth, 5u);
+  ASSERT_EQ(stats.queue_depth, 0u);
+  ASSERT_GE(stats.max_latency, stats.last_latency);
+}
+
+TEST(CanTransmitterTest, retriesWhenBufferIsFull)
+{
+  FakeWriter writer;
+  writer.failures_ = 3;
+  writer.error_    = ENOBUFS;
+  CanTransmitter transmitter([&writer](const can::Frame& f) { return writer.write(f); },
+                             System::getLogger());
+  Completions completions;
+  transmitter.start();
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x601), completions.getCallback()));
+  completions.waitFor(1);
+
+  ASSERT_EQ(completions.sent_, 1);
+  ASSERT_EQ(transmitter.getStats().retries, 3u);
+  ASSERT_EQ(transmitter.getStats().sent, 1u);
+}
+
+TEST(CanTransmitterTest, failsAfterRetriesOrHardError)
+{
+  FakeWriter writer;
+  writer.failures_ = 1000;
+  writer.error_    = EAGAIN;
+  CanTransmitter transmitter([&writer](const can::Frame& f) { return writer.write(f); },
+                             System::getLogger());
+  Completions completions;
+  can::TxCallback callback = completions.getCallback();
+  transmitter.start();
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x601), callback));
+  completions.waitFor(1);
+  ASSERT_EQ(transmitter.getStats().retries, CanTransmitter::kMaxAttempts - 1);
+
+  writer.error_ = ENETDOWN;   // not retried
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x601), callback));
+  completions.waitFor(2);
+  ASSERT_EQ(completions.failed_, 2);
+  ASSERT_EQ(transmitter.getStats().retries, CanTransmitter::kMaxAttempts - 1);
+  ASSERT_EQ(transmitter.getStats().failed, 2u);
+}
+
+TEST(CanTransmitterTest, rejectsFramesWhenFull)
+{
+  FakeWriter writer;
+  CanTransmitter transmitter([&writer](const can::Frame& f) { return writer.write(f); },
+                             System::getLogger(), 2);
+  Completions completions;
+  can::TxCallback callback = completions.getCallback();
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x601), callback));
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x602), callback));
+  ASSERT_FALSE(transmitter.enqueue(makeFrame(0x603), callback));
+  ASSERT_EQ(transmitter.getStats().rejected, 1u);
+  ASSERT_EQ(transmitter.getStats().queue_depth, 2u);
+
+  // stopping fails everything still queued
+  transmitter.start();
+  transmitter.stop();
+  ASSERT_EQ(completions.sent_ + completions.failed_, 2);
+  ASSERT_FALSE(transmitter.enqueue(makeFrame(0x601), callback));
+}
+
+TEST(CanTransmitterTest, stopWithoutStartFailsQueuedFrames)
+{
+  FakeWriter writer;
+  CanTransmitter transmitter([&writer](const can::Frame& f) { return writer.write(f); },
+                             System::getLogger());
+  Completions completions;
+  can::TxCallback callback = completions.getCallback();
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x601), callback));
+  ASSERT_TRUE(transmitter.enqueue(makeFrame(0x602), callback));
+
+  transmitter.stop();
+  ASSERT_EQ(completions.failed_, 2);
+  ASSERT_EQ(transmitter.getStats().failed, 2u);
+  ASSERT_EQ(transmitter.getStats().queue_depth, 0u);
+  ASSERT_TRUE(writer.getWritten().empty());
+}
+
+}}}  // namespace hyped::utils::io
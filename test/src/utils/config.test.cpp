@@ -61,4 +61,10 @@ TEST_F(utils_config, test_config_reads_subconfig_file)
   }
 }
 
+TEST_F(utils_config, test_config_reads_can_interfaces)
+{
+  ASSERT_EQ(config->can.motors, "vcan1");
+  ASSERT_EQ(config->can.bms, "can0");   // default
+}
+
 // TEST_F(configTest, )
@@ -0,0 +1,163 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that utils::io::GpioMonitor reports edges of many fds from one thread
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
+
+#include "gtest/gtest.h"
+#include "utils/concurrent/thread.hpp"
+#include "utils/io/gpio_monitor.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+namespace io {
+
+/**
+ * @brief Records the edges it is handed
+ */
+class EdgeRecorder : public GpioMonitor::Listener {
+ public:
+  EdgeRecorder() : edges_(0), value_(0), time_(0) {}
+
+  void onEdge(uint8_t value, uint64_t time) override
+  {
+    value_ = value;
+    time_  = time;
+    edges_++;
+  }
+
+  /**
+   * @return true once count edges were recorded, false if not within a second
+   */
+  bool waitForEdges(int count)
+  {
+    for (int i = 0; i < 1000 && edges_ < count; i++) concurrent::Thread::sleep(1);
+    return edges_ >= count;
+  }
+
+  std::atomic<int>      edges_;
+  std::atomic<uint8_t>  value_;
+  std::atomic<uint64_t> time_;
+};
+
+/**
+ * @brief Pipes stand in for the value files of the pins, a write is an edge
+ */
+class GpioMonitorTest : public ::testing::Test {
+ protected:
+  static constexpr int kNumPins = 2;
+
+  GpioMonitorTest() : log_(false, -1), monitor_(log_), started_(false) {}
+
+  void SetUp() override
+  {
+    for (int* pin : pins_) {
+      ASSERT_EQ(pipe2(pin, O_NONBLOCK), 0);
+      setPin(pin, 0);
+    }
+  }
+
+  void TearDown() override
+  {
+    if (started_) {
+      monitor_.stop();
+      monitor_.join();
+    }
+    for (int* pin : pins_) {
+      close(pin[0]);
+      close(pin[1]);
+    }
+  }
+
+  void start()
+  {
+    monitor_.start();
+    started_ = true;
+  }
+
+  static void setPin(int* pin, uint8_t value)
+  {
+    char buf[2] = {static_cast<char>('0' + value), '\n'};
+    ASSERT_EQ(write(pin[1], buf, sizeof(buf)), 2);
+  }
+
+  Logger        log_;
+  GpioMonitor   monitor_;
+  int           pins_[kNumPins][2];
+  EdgeRecorder  recorders_[kNumPins];
+  bool          started_;
+};
+
+constexpr int GpioMonitorTest::kNumPins;
+
+TEST_F(GpioMonitorTest, reportsCurrentValueOnWatch)
+{
+  setPin(pins_[0], 1);
+  ASSERT_TRUE(monitor_.watch(pins_[0][0], &recorders_[0]));
+  ASSERT_EQ(recorders_[0].edges_, 1);
+  ASSERT_EQ(recorders_[0].value_, 1);
+  start();
+}
+
+TEST_F(GpioMonitorTest, reportsEdgesOfAllPinsFromOneThread)
+{
+  for (int i = 0; i < kNumPins; i++) {
+    ASSERT_TRUE(monitor_.watch(pins_[i][0], &recorders_[i]));
+  }
+  start();
+
+  uint64_t before = Timer::getTimeMicros();
+  setPin(pins_[1], 1);
+  ASSERT_TRUE(recorders_[1].waitForEdges(2));
+  ASSERT_EQ(recorders_[1].value_, 1);
+  ASSERT_GE(recorders_[1].time_, before);
+  RecordProperty("edge_latency_us", static_cast<int>(recorders_[1].time_ - before));
+  ASSERT_LT(recorders_[1].time_ - before, 10000u);
+
+  setPin(pins_[0], 1);
+  setPin(pins_[0], 0);
+  setPin(pins_[0], 1);
+  ASSERT_TRUE(recorders_[0].waitForEdges(2));
+  concurrent::Thread::sleep(10);
+  // the writes were drained at once, only the last value counts
+  ASSERT_EQ(recorders_[0].value_, 1);
+  ASSERT_EQ(recorders_[1].edges_, 2);
+}
+
+TEST_F(GpioMonitorTest, ignoresUnchangedValue)
+{
+  ASSERT_TRUE(monitor_.watch(pins_[0][0], &recorders_[0]));
+  start();
+  setPin(pins_[0], 0);
+  setPin(pins_[0], 1);
+  ASSERT_TRUE(recorders_[0].waitForEdges(2));
+  setPin(pins_[0], 1);
+  concurrent::Thread::sleep(10);
+  ASSERT_EQ(recorders_[0].edges_, 2);
+}
+
+TEST_F(GpioMonitorTest, rejectsInvalidFd)
+{
+  ASSERT_FALSE(monitor_.watch(-1, &recorders_[0]));
+  ASSERT_EQ(recorders_[0].edges_, 0);
+  start();
+}
+
+}}}   // namespace hyped::utils::io
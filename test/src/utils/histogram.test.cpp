@@ -0,0 +1,67 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests the buckets and summary statistics of utils::math::Histogram
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "utils/math/histogram.hpp"
+
+namespace hyped {
+namespace utils {
+namespace math {
+
+TEST(HistogramTest, isEmptyInitially)
+{
+  Histogram histogram;
+  ASSERT_EQ(histogram.getCount(), 0u);
+  ASSERT_EQ(histogram.getMin(), 0u);
+  ASSERT_EQ(histogram.getMax(), 0u);
+  ASSERT_EQ(histogram.getMean(), 0.0);
+  ASSERT_EQ(histogram.getPercentile(0.99), 0u);
+}
+
+TEST(HistogramTest, countsValuesInPowerOfTwoBuckets)
+{
+  Histogram histogram;
+  for (uint64_t value : {0, 1, 2, 3, 4, 7, 8, 1000}) histogram.add(value);
+  ASSERT_EQ(histogram.getBucket(0), 1u);    // 0
+  ASSERT_EQ(histogram.getBucket(1), 1u);    // 1
+  ASSERT_EQ(histogram.getBucket(2), 2u);    // 2..3
+  ASSERT_EQ(histogram.getBucket(3), 2u);    // 4..7
+  ASSERT_EQ(histogram.getBucket(4), 1u);    // 8..15
+  ASSERT_EQ(histogram.getBucket(10), 1u);   // 512..1023
+  ASSERT_EQ(histogram.getCount(), 8u);
+
+  histogram.add(UINT64_MAX);
+  ASSERT_EQ(histogram.getBucket(Histogram::kNumBuckets - 1), 1u);
+  ASSERT_EQ(Histogram::getUpperBound(Histogram::kNumBuckets - 1), UINT64_MAX);
+}
+
+TEST(HistogramTest, summarisesValues)
+{
+  Histogram histogram;
+  for (uint64_t value = 1; value <= 100; value++) histogram.add(value);
+  ASSERT_EQ(histogram.getMin(), 1u);
+  ASSERT_EQ(histogram.getMax(), 100u);
+  ASSERT_DOUBLE_EQ(histogram.getMean(), 50.5);
+
+  // the 50th value lies in 32..63, the 99th in 64..127 which is clamped to the largest value
+  ASSERT_EQ(histogram.getPercentile(0.5), 63u);
+  ASSERT_EQ(histogram.getPercentile(0.99), 100u);
+  ASSERT_EQ(histogram.getPercentile(0), 1u);
+  ASSERT_EQ(histogram.getPercentile(1), 100u);
+}
+
+}}}  // namespace hyped::utils::math
@@ -0,0 +1,163 @@
+/*
+ * Organisation: HYPED
+ * Date: 18/10/2026
+ * Description: Tests that threads on a utils::SimulationClock take turns in virtual time
+ *
+ *    Copyright 2026 HYPED
+ *    Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ *    except in compliance with the License. You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software distributed under
+ *    the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ *    either express or implied. See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "utils/clock.hpp"
+#include "utils/concurrent/condition_variable.hpp"
+#include "utils/concurrent/lock.hpp"
+#include "utils/concurrent/thread.hpp"
+#include "utils/timer.hpp"
+
+namespace hyped {
+namespace utils {
+
+/**
+ * @brief Sleeps period between steps and records when it ran, into a log shared with the others
+ */
+class SleepingThread : public concurrent::Thread {
+ public:
+  SleepingThread(int id, uint32_t period, int steps, std::vector<int>* log)
+      : id_(id), period_(period), steps_(steps), log_(log) {}
+
+  void run() override
+  {
+    for (int i = 0; i < steps_; i++) {
+      concurrent::Thread::sleep(period_);
+      log_->push_back(id_);
+      times_.push_back(Timer::getTimeMicros());
+    }
+  }
+
+  int               id_;
+  uint32_t          period_;    // milliseconds
+  int               steps_;
+  std::vector<int>* log_;
+  std::vector<uint64_t> times_;
+};
+
+class SimulationClockTest : public ::testing::Test {
+ protected:
+  SimulationClockTest() : clock_(1000) {}
+
+  void SetUp() override
+  {
+    clock_.install();
+    clock_.attach();
+  }
+
+  void TearDown() override
+  {
+    clock_.detach();
+    clock_.uninstall();
+  }
+
+  SimulationClock clock_;
+};
+
+TEST_F(SimulationClockTest, threadsRunInOrderOfTime)
+{
+  std::vector<int> log;
+  SleepingThread fast(0, 2, 3, &log);
+  SleepingThread slow(1, 3, 2, &log);
+  fast.start();
+  slow.start();
+  fast.join();
+  slow.join();
+
+  // the clock jumps to each wake up, at 7 ms the thread that waited first goes first
+  ASSERT_EQ(log, std::vector<int>({0, 1, 0, 1, 0}));
+  ASSERT_EQ(fast.times_, std::vector<uint64_t>({3000, 5000, 7000}));
+  ASSERT_EQ(slow.times_, std::vector<uint64_t>({4000, 7000}));
+  ASSERT_EQ(Timer::getTimeMicros(), 7000u);
+  ASSERT_EQ(clock_.getTimeMicros(), 7000u);
+}
+
+/**
+ * @brief Waits on a condition variable until its flag is set
+ */
+class Waiter : public concurrent::Thread {
+ public:
+  Waiter() : flag_(false), notified_(false), time_(0) {}
+
+  void run() override
+  {
+    lock_.lock();
+    while (!flag_) notified_ = cv_.waitFor(&lock_, 1000000);
+    lock_.unlock();
+    time_ = Timer::getTimeMicros();
+  }
+
+  concurrent::Lock              lock_;
+  concurrent::ConditionVariable cv_;
+  bool                          flag_;
+  bool                          notified_;
+  uint64_t                      time_;
+};
+
+TEST_F(SimulationClockTest, notifyWakesWaiterAtOnce)
+{
+  Waiter waiter;
+  waiter.start();
+  concurrent::Thread::sleep(5);
+
+  waiter.lock_.lock();
+  waiter.flag_ = true;
+  waiter.cv_.notify();
+  waiter.lock_.unlock();
+  waiter.join();
+
+  ASSERT_TRUE(waiter.notified_);
+  ASSERT_EQ(waiter.time_, 6000u);
+}
+
+TEST_F(SimulationClockTest, waitTimesOutInVirtualTime)
+{
+  Waiter waiter;
+  waiter.start();
+  concurrent::Thread::sleep(1500);
+  ASSERT_FALSE(waiter.notified_);
+  waiter.flag_ = true;
+  waiter.join();
+  // timed out at 1 s and 2 s, the flag was seen after the second timeout
+  ASSERT_EQ(waiter.time_, 2001000u);
+}
+
+TEST_F(SimulationClockTest, notifyFromOutsideWakesWaiter)
+{
+  // the only attached thread waits for ever, so the clock stands still until the notification
+  concurrent::Lock              lock;
+  concurrent::ConditionVariable cv;
+  bool                          flag = false;
+  lock.lock();
+  std::thread outside([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    concurrent::ScopedLock L(&lock);
+    flag = true;
+    cv.notify();
+  });
+  while (!flag) cv.wait(&lock);
+  lock.unlock();
+  outside.join();
+  ASSERT_EQ(Timer::getTimeMicros(), 1000u);
+}
+
+}}  // namespace hyped::utils
@@ -3,7 +3,8 @@
 CFLAGS   := $(CFLAGS) -pthread -Wall
 LFLAGS   := $(LFLAGS) -lpthread -pthread
 CC       := g++
-INC_DIR  := $(INC_DIR) -I$(SRCS_DIR) -I$(LIBS_DIR)
+GEN_DIR  := $(OBJS_DIR)/generated
+INC_DIR  := $(INC_DIR) -I$(SRCS_DIR) -I$(LIBS_DIR) -I$(GEN_DIR)
 DEPFLAGS  = -MT $@ -MMD -MP -MF $(OBJS_DIR)/$*.d
 # DEPFLAGS ensures that changes to headers trigger recompilation properly. More info on the wiki:
 # https://github.com/Hyp-ed/hyped-2020/wiki/Makefiles#what-is-the-line-depflags----mt---mmd--mp--mf-objs_dird-in-buildmk
@@ -57,6 +58,20 @@ endif
 
 LL := $(CC)
 
+# Sources generated from data files, every object waits for them so that the first build finds
+# them. Later changes are picked up through the dependency files.
+GEN_PYTHON        := $(shell command -v python3 || command -v python2.7 || command -v python)
+CONTROLLER_MSGS   := $(wildcard data/in/controllerConfigFiles/*.txt)
+GENERATED         := $(GEN_DIR)/propulsion/controller_messages.hpp
+
+ifeq ($(GEN_PYTHON), )
+    $(error Python is needed to generate $(GENERATED))
+endif
+
+$(GENERATED): utils/build/controller_messages.py $(CONTROLLER_MSGS)
+	$(Echo) "Generating $@"
+	$(Verb) $(GEN_PYTHON) $< $@ $(CONTROLLER_MSGS)
+
 # auto-discover all sources
 SRCS      := $(shell find $(SRCS_DIR) -name '*.cpp')
 OBJS      := $(patsubst $(SRCS_DIR)%.cpp,$(OBJS_DIR)%.o,$(SRCS))
@@ -66,6 +81,8 @@ $(TARGET): $(DEPENDENCIES) $(OBJS) $(MAIN_OBJ)
 	$(Echo) "Linking executable $(MAIN) into $@"
 	$(Verb) $(LL)  -o $@ $(OBJS) $(MAIN_OBJ) $(LFLAGS) $(COVERAGE_FLAGS)
 
+$(OBJS) $(MAIN_OBJ): | $(GENERATED)
+
 $(MAIN_OBJ): $(OBJS_DIR)/%.o: $(MAIN)
 	$(Echo) "Compiling main: $<"
 	$(Verb) mkdir -p $(dir $@)
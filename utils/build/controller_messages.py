@@ -0,0 +1,113 @@
+#!/usr/bin/env python
+#
+# Organisation: HYPED
+# Date: 18/10/2026
+# Description: Compiles the motor controller message files into a header of constexpr
+# ControllerMessage tables, so controllers do not parse text files at startup.
+#
+# usage: controller_messages.py <output header> <message files...>
+#
+# Every file becomes one table named after it, e.g. enter_preOperational.txt gives
+# kEnterPreOperational. The format is the one FileReader reads: '#' starts a comment, a line
+# starting with '>' is the logger output of the next message and any other non-empty line holds
+# the 8 bytes of a message in hex. Files without messages are skipped.
+
+import os
+import sys
+
+LOGGER_OUTPUT_SIZE = 250   # size of ControllerMessage::logger_output
+MESSAGE_LENGTH = 8
+
+
+def fail(path, number, reason):
+  sys.stderr.write('%s:%d: %s\n' % (path, number, reason))
+  sys.exit(1)
+
+
+def table_name(path):
+  name = os.path.splitext(os.path.basename(path))[0]
+  words = name.split('_')
+  return 'k' + ''.join(word[0].upper() + word[1:] for word in words if word)
+
+
+def escape(text):
+  return text.replace('\\', '\\\\').replace('"', '\\"')
+
+
+def parse(path):
+  messages = []
+  logger_output = ''
+  with open(path) as f:
+    for number, line in enumerate(f, 1):
+      line = line.rstrip('\r\n')
+      if not line.strip() or line.startswith('#'):
+        continue
+      if line.startswith('>'):
+        logger_output = line[1:].rstrip()
+        if len(logger_output) >= LOGGER_OUTPUT_SIZE:
+          fail(path, number, 'logger output longer than %d characters' % (LOGGER_OUTPUT_SIZE - 1))
+        continue
+      tokens = line.split()
+      if len(tokens) != MESSAGE_LENGTH:
+        fail(path, number, 'expected %d bytes, got %d' % (MESSAGE_LENGTH, len(tokens)))
+      try:
+        data = [int(token, 16) for token in tokens]
+      except ValueError:
+        fail(path, number, 'bytes must be hexadecimal')
+      if any(byte < -0x80 or byte > 0xFF for byte in data):
+        fail(path, number, 'byte out of range')
+      # negative values are written in two's complement, e.g. -0x04 for modes of operation
+      messages.append(([byte & 0xFF for byte in data], logger_output))
+      logger_output = ''
+  return messages
+
+
+def generate(paths):
+  out = []
+  out.append('// Generated by utils/build/controller_messages.py, do not edit.')
+  out.append('// Sources:')
+  for path in paths:
+    out.append('//   %s' % path)
+  out.append('')
+  out.append('#ifndef PROPULSION_CONTROLLER_MESSAGES_HPP_')
+  out.append('#define PROPULSION_CONTROLLER_MESSAGES_HPP_')
+  out.append('')
+  out.append('#include "propulsion/controller_interface.hpp"')
+  out.append('')
+  out.append('namespace hyped {')
+  out.append('namespace motor_control {')
+  out.append('namespace messages {')
+  for path in paths:
+    messages = parse(path)
+    if not messages:
+      continue
+    out.append('')
+    out.append('// %s' % os.path.basename(path))
+    out.append('constexpr ControllerMessage %s[%d] = {' % (table_name(path), len(messages)))
+    for data, logger_output in messages:
+      out.append('  {{%s}, %d, "%s"},' % (', '.join('0x%02X' % byte for byte in data),
+                                          MESSAGE_LENGTH, escape(logger_output)))
+    out.append('};')
+  out.append('')
+  out.append('}}}  // namespace hyped::motor_control::messages')
+  out.append('')
+  out.append('#endif  // PROPULSION_CONTROLLER_MESSAGES_HPP_')
+  return '\n'.join(out) + '\n'
+
+
+def main():
+  if len(sys.argv) < 3:
+    sys.stderr.write('usage: %s <output header> <message files...>\n' % sys.argv[0])
+    sys.exit(2)
+  header = sys.argv[1]
+  content = generate(sorted(sys.argv[2:]))
+
+  directory = os.path.dirname(header)
+  if directory and not os.path.isdir(directory):
+    os.makedirs(directory)
+  with open(header, 'w') as f:
+    f.write(content)
+
+
+if __name__ == '__main__':
+  main()
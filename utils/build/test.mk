@@ -77,6 +77,8 @@ $(T_TARGET): $(DEPENDENCIES) $(OBJS) $(T_OBJS)
 	$(Echo) "Linking test executable $@"
 	$(Verb) $(LL) -o $@ $(OBJS) $(T_OBJS) $(T_LFLAGS) $(COVERAGE_FLAGS)
 
+$(T_OBJS): | $(GENERATED)
+
 $(T_OBJS): $(T_OBJ_DIR)/%.o: $(T_SRC_DIR)/%.cpp $(GTEST_TARGET)
 	$(Echo) "Compiling $<"
 	$(Verb) mkdir -p $(dir $@)